@@ -0,0 +1,85 @@
+/* Microbenchmark of the types::dict backend against std::unordered_map.
+ *
+ * Build from the repository root with:
+ *
+ *   g++ -std=c++11 -O2 -DNDEBUG -march=native -Ipythran -Ithird_party \
+ *       benchmarks/dict.cpp -o dict_bench
+ */
+#include "pythonic/core.hpp"
+#include "pythonic/types/tuple.hpp"
+#include "pythonic/utils/flat_hash_map.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using namespace pythonic;
+
+template <class F>
+double timeit(F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <class Map, class K>
+void run(char const *name, std::vector<K> const &keys)
+{
+  // look keys up in an order unrelated to the insertion one
+  std::vector<K> shuffled = keys;
+  std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937_64(1));
+
+  Map map;
+  long checksum = 0;
+  double insert = timeit([&]() {
+    for (size_t i = 0; i < keys.size(); ++i)
+      map[keys[i]] += i;
+  });
+  double lookup = timeit([&]() {
+    for (int repeat = 0; repeat < 4; ++repeat)
+      for (auto const &key : shuffled)
+        checksum += map.find(key)->second;
+  });
+  double iterate = timeit([&]() {
+    for (int repeat = 0; repeat < 16; ++repeat)
+      for (auto const &kv : map)
+        checksum += kv.second;
+  });
+  double erase = timeit([&]() {
+    for (size_t i = 0; i < keys.size(); i += 2) {
+      auto where = map.find(keys[i]);
+      if (where != map.end())
+        map.erase(where);
+    }
+  });
+  std::printf("%-28s insert %6.3fs  lookup %6.3fs  iterate %6.3fs  erase "
+              "%6.3fs  (%ld)\n",
+              name, insert, lookup, iterate, erase, checksum);
+}
+
+int main()
+{
+  std::mt19937_64 gen(0);
+  size_t const n = 1 << 21;
+
+  std::vector<long> ikeys(n);
+  for (auto &key : ikeys)
+    key = gen() % (4 * n);
+  run<std::unordered_map<long, long>>("unordered_map<long>", ikeys);
+  run<utils::flat_hash_map<long, long>>("flat_hash_map<long>", ikeys);
+
+  std::vector<std::tuple<long, long>> tkeys(n);
+  for (auto &key : tkeys)
+    key = std::make_tuple(long(gen() % 2048), long(gen() % 2048));
+  run<std::unordered_map<std::tuple<long, long>, long>>(
+      "unordered_map<tuple>", tkeys);
+  run<utils::flat_hash_map<std::tuple<long, long>, long>>(
+      "flat_hash_map<tuple>", tkeys);
+  return 0;
+}
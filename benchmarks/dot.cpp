@@ -0,0 +1,97 @@
+/* Microbenchmark of the in-tree matrix multiplication kernels of
+ * utils/gemm.hpp against the BLAS path of numpy.dot.
+ *
+ * Build from the repository root with:
+ *
+ *   g++ -std=c++11 -O2 -DNDEBUG -DUSE_XSIMD -march=native -Ipythran \
+ *       -Ithird_party benchmarks/dot.cpp -o dot_bench -lopenblas
+ *
+ * Double precision products are timed through both numpy.dot, which calls
+ * cblas_dgemm, and utils::gemm directly. Integer and mixed products, which
+ * have no BLAS counterpart, are timed against the naive triple loop that
+ * numpy.dot used before.
+ */
+#include "pythonic/core.hpp"
+#include "pythonic/numpy/dot.hpp"
+#include "pythonic/numpy/transpose.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace pythonic;
+
+template <class F>
+double timeit(F f)
+{
+  auto start = std::chrono::steady_clock::now();
+  f();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+template <class T>
+types::ndarray<T, types::array<long, 2>> random_matrix(long m, long n)
+{
+  static std::mt19937_64 rng(0);
+  types::ndarray<T, types::array<long, 2>> out(types::array<long, 2>{{m, n}},
+                                               __builtin__::None);
+  for (long i = 0; i < m * n; ++i)
+    out.buffer[i] = T(long(rng() % 201) - 100) / T(4);
+  return out;
+}
+
+template <class T, class E, class F>
+types::ndarray<T, types::array<long, 2>> naive_dot(E const &e, F const &f)
+{
+  long m = std::get<0>(e.shape()), k = std::get<1>(e.shape()),
+       n = std::get<1>(f.shape());
+  types::ndarray<T, types::array<long, 2>> out(types::array<long, 2>{{m, n}},
+                                               T(0));
+  for (long i = 0; i < m; i++)
+    for (long j = 0; j < n; j++)
+      for (long p = 0; p < k; p++)
+        out[types::array<long, 2>{{i, j}}] +=
+            e[types::array<long, 2>{{i, p}}] * f[types::array<long, 2>{{p, j}}];
+  return out;
+}
+
+double gflops(long n, double seconds)
+{
+  return 2. * n * n * n / seconds * 1e-9;
+}
+
+int main()
+{
+  std::printf("%6s %12s %12s %12s %12s %12s\n", "n", "dgemm", "gemm<f8>",
+              "gemm<i8>", "naive<i8>", "gemm<i8,f8>");
+  for (long n : {64, 128, 256, 512, 1024}) {
+    auto a = random_matrix<double>(n, n);
+    auto b = random_matrix<double>(n, n);
+    auto ia = random_matrix<long>(n, n);
+    auto ib = random_matrix<long>(n, n);
+    types::ndarray<double, types::array<long, 2>> out(
+        types::array<long, 2>{{n, n}}, __builtin__::None);
+    double checksum = 0;
+
+    double blas = timeit([&]() { checksum += numpy::dot(a, b).buffer[0]; });
+    double intree = timeit([&]() {
+      utils::gemm(n, n, n, numpy::details::make_matrix_view(a),
+                  numpy::details::make_matrix_view(b), out.buffer);
+      checksum += out.buffer[0];
+    });
+    double integer = timeit([&]() {
+      checksum += numpy::dot(ia, numpy::transpose(ib)).buffer[0];
+    });
+    double naive = n > 512 ? 0. : timeit([&]() {
+      checksum += naive_dot<long>(ia, numpy::transpose(ib)).buffer[0];
+    });
+    double mixed = timeit([&]() { checksum += numpy::dot(ia, b).buffer[0]; });
+
+    std::printf("%6ld %12.2f %12.2f %12.2f %12.2f %12.2f   (GFLOP/s, %g)\n", n,
+                gflops(n, blas), gflops(n, intree), gflops(n, integer),
+                naive ? gflops(n, naive) : 0., gflops(n, mixed), checksum);
+  }
+  return 0;
+}
@@ -0,0 +1,131 @@
+/* Benchmark suite for the dense linear algebra functions that depend on the
+ * ``blas`` setting: numpy.dot, inner, outer, linalg.matrix_power and
+ * linalg.norm.
+ *
+ * Build it twice from the repository root, once against a BLAS library and
+ * once with ``blas=none``, that is with the in-tree kernels:
+ *
+ *   g++ -std=c++11 -O2 -DNDEBUG -DUSE_XSIMD -march=native -Ipythran \
+ *       -Ithird_party benchmarks/linalg.cpp -o linalg_blas -lopenblas
+ *   g++ -std=c++11 -O2 -DNDEBUG -DUSE_XSIMD -march=native -Ipythran \
+ *       -Ithird_party -DPYTHRAN_BLAS_NONE benchmarks/linalg.cpp \
+ *       -o linalg_none
+ *
+ * and compare the timings, in milliseconds, printed by each binary.
+ */
+#include "pythonic/core.hpp"
+#include "pythonic/numpy/dot.hpp"
+#include "pythonic/numpy/inner.hpp"
+#include "pythonic/numpy/outer.hpp"
+#include "pythonic/numpy/transpose.hpp"
+#include "pythonic/numpy/linalg/matrix_power.hpp"
+#include "pythonic/numpy/linalg/norm.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+
+using namespace pythonic;
+
+// best of a few runs, in milliseconds
+template <class F>
+double timeit(F f)
+{
+  double best = 1e300;
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+template <class T>
+types::ndarray<T, types::array<long, 2>> random_matrix(long m, long n)
+{
+  static std::mt19937_64 rng(0);
+  std::uniform_real_distribution<double> dist(-1., 1.);
+  types::ndarray<T, types::array<long, 2>> out(types::array<long, 2>{{m, n}},
+                                               __builtin__::None);
+  for (long i = 0; i < m * n; ++i)
+    out.buffer[i] = T(dist(rng));
+  return out;
+}
+
+template <class T>
+types::ndarray<T, types::pshape<long>> random_vector(long n)
+{
+  static std::mt19937_64 rng(1);
+  std::uniform_real_distribution<double> dist(-1., 1.);
+  types::ndarray<T, types::pshape<long>> out(types::pshape<long>{n},
+                                             __builtin__::None);
+  for (long i = 0; i < n; ++i)
+    out.buffer[i] = T(dist(rng));
+  return out;
+}
+
+double checksum = 0;
+
+template <class T>
+void run(char const *dtype)
+{
+  for (long n : {64, 256, 1024}) {
+    auto a = random_matrix<T>(n, n);
+    auto b = random_matrix<T>(n, n);
+    auto x = random_vector<T>(n);
+    auto y = random_vector<T>(n);
+    // keep matrix powers bounded
+    auto scaled = random_matrix<T>(n, n);
+    for (long i = 0; i < n * n; ++i)
+      scaled.buffer[i] /= T(n);
+
+    std::printf("%-8s %6ld", dtype, n);
+    std::printf(" %10.3f", timeit([&]() {
+                  checksum += std::abs(numpy::dot(a, b).buffer[0]);
+                }));
+    std::printf(" %10.3f", timeit([&]() {
+                  checksum +=
+                      std::abs(numpy::dot(numpy::transpose(a), b).buffer[0]);
+                }));
+    std::printf(" %10.3f", timeit([&]() {
+                  checksum += std::abs(numpy::dot(a, x).buffer[0]);
+                }));
+    std::printf(" %10.3f", timeit([&]() {
+                  checksum += std::abs(numpy::dot(x, a).buffer[0]);
+                }));
+    std::printf(" %10.3f", timeit([&]() {
+                  for (int i = 0; i < 100; ++i)
+                    checksum += std::abs(numpy::functor::inner{}(x, y));
+                }));
+    std::printf(" %10.3f", timeit([&]() {
+                  checksum += std::abs(numpy::outer(x, y).buffer[0]);
+                }));
+    std::printf(" %10.3f", timeit([&]() {
+                  checksum += std::abs(
+                      numpy::linalg::matrix_power(scaled, 7).buffer[0]);
+                }));
+    std::printf(" %10.3f\n", timeit([&]() {
+                  for (int i = 0; i < 100; ++i)
+                    checksum += numpy::linalg::norm(x);
+                }));
+  }
+}
+
+int main()
+{
+#ifdef PYTHRAN_BLAS_NONE
+  std::printf("blas=none\n");
+#else
+  std::printf("blas=cblas\n");
+#endif
+  std::printf("%-8s %6s %10s %10s %10s %10s %10s %10s %10s %10s\n", "dtype",
+              "n", "gemm", "gemm(T)", "gemv", "gevm", "inner*100", "outer",
+              "mpow(7)", "norm*100");
+  run<double>("float64");
+  run<float>("float32");
+  std::printf("(checksum %g)\n", checksum);
+  return 0;
+}
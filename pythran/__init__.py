@@ -7,6 +7,7 @@ This package provides several entry points
        * compile_cxxcode: c++ (str) to DLL, returns DLL filename
        * compile_pythrancode: python (str) to so/cpp, returns output filename
        * compile_pythranfile: python (file) to so/cpp, returns output filename
+       * compile_pythranfiles: several python files to so/cpp, concurrently
        * test_compile: passthrough compile test, raises CompileError Exception.
 
 Basic scenario is to turn a Python AST into C++ code:
@@ -39,7 +40,7 @@ Cleanup
 import pythran.log
 from pythran.toolchain import (generate_cxx, compile_cxxfile, compile_cxxcode,
                                compile_pythrancode, compile_pythranfile,
-                               test_compile)
+                               compile_pythranfiles, test_compile)
 from pythran.spec import spec_parser
 from pythran.spec import load_specfile
 from pythran.dist import PythranExtension
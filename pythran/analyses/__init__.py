@@ -14,6 +14,7 @@ from .ancestors import Ancestors
 from .argument_effects import ArgumentEffects
 from .argument_read_once import ArgumentReadOnce
 from .ast_matcher import ASTMatcher, AST_any, AST_or, Placeholder, Check
+from .borrowed_arguments import BorrowedArguments
 from .cfg import CFG
 from .constant_expressions import ConstantExpressions
 from .dependencies import Dependencies
@@ -0,0 +1,126 @@
+"""
+BorrowedArguments gathers the arguments that do not need to be converted.
+"""
+
+from pythran.analyses.ancestors import Ancestors
+from pythran.analyses.argument_effects import ArgumentEffects
+from pythran.analyses.use_omp import UseOMP
+from pythran.analyses.yield_points import YieldPoints
+from pythran.passmanager import ModuleAnalysis
+
+import gast as ast
+
+
+class BorrowedArguments(ModuleAnalysis):
+
+    """
+    Gathers, for each function, the indices of the arguments it only reads
+    through iteration, indexing by a literal or an integer expression,
+    membership tests and len.
+
+    An exported function can access such a container argument in place,
+    instead of converting it when it is called. Elements are converted when
+    accessed, so an argument accessed from within a loop that does not
+    iterate over it is not borrowed.
+
+    >>> import gast as ast
+    >>> from pythran import passmanager
+    >>> from pythran.transformations import ExpandBuiltins
+    >>> pm = passmanager.PassManager("test")
+    >>> node = ast.parse('''
+    ... def foo(l, d, m, n, o, k):
+    ...     s = len(l) + d['a'] + o[len(o) - 1] + o[k]
+    ...     for x in l:
+    ...         s += x + len(m)
+    ...     for i in range(3):
+    ...         s += m[i]
+    ...     n[0] = s
+    ...     return s''')
+    >>> _, node = pm.apply(ExpandBuiltins, node)
+    >>> res = pm.gather(BorrowedArguments, node)
+    >>> sorted(res[node.body[0]])
+    [0, 1]
+    """
+
+    loops = (ast.For, ast.While, ast.ListComp, ast.SetComp, ast.DictComp,
+             ast.GeneratorExp)
+
+    integral_ops = (ast.Add, ast.Sub, ast.Mult, ast.FloorDiv, ast.Mod,
+                    ast.LShift, ast.RShift, ast.BitOr, ast.BitXor, ast.BitAnd)
+
+    def __init__(self):
+        self.result = dict()
+        super(BorrowedArguments, self).__init__(Ancestors, ArgumentEffects)
+
+    def integral(self, node):
+        """Whether `node' is built from integer literals and len only."""
+        if isinstance(node, ast.Constant):
+            return isinstance(node.value, int)
+        if isinstance(node, ast.UnaryOp):
+            return (isinstance(node.op, (ast.USub, ast.UAdd, ast.Invert)) and
+                    self.integral(node.operand))
+        if isinstance(node, ast.BinOp):
+            return (isinstance(node.op, BorrowedArguments.integral_ops) and
+                    self.integral(node.left) and self.integral(node.right))
+        return self.is_len(node)
+
+    @staticmethod
+    def is_len(node):
+        return (isinstance(node, ast.Call) and
+                isinstance(node.func, ast.Attribute) and
+                isinstance(node.func.value, ast.Name) and
+                node.func.value.id == '__builtin__' and
+                node.func.attr == 'len' and len(node.args) == 1)
+
+    def index(self, node):
+        """
+        Whether `node' is a valid index for both views: a borrowed list only
+        takes integers, and a variable could hold a slice.
+        """
+        return isinstance(node, ast.Constant) or self.integral(node)
+
+    def repeated(self, node):
+        """Whether `node' may be evaluated several times per call."""
+        return any(isinstance(n, BorrowedArguments.loops)
+                   for n in self.ancestors[node])
+
+    def borrowable(self, use):
+        parent = self.ancestors[use][-1]
+        if isinstance(parent, ast.Call):
+            # the size of the container does not need any conversion
+            return self.is_len(parent) and parent.args == [use]
+        if isinstance(parent, ast.For):
+            return use is parent.iter and not self.repeated(parent)
+        if isinstance(parent, ast.comprehension):
+            comp = self.ancestors[parent][-1]
+            return (use is parent.iter and parent is comp.generators[0] and
+                    not self.repeated(comp))
+        if isinstance(parent, ast.Subscript):
+            return (use is parent.value and
+                    isinstance(parent.ctx, ast.Load) and
+                    isinstance(parent.slice, ast.Index) and
+                    self.index(parent.slice.value) and
+                    not self.repeated(parent))
+        if isinstance(parent, ast.Compare):
+            return (any(use is comparator and isinstance(op, (ast.In,
+                                                              ast.NotIn))
+                        for op, comparator in zip(parent.ops,
+                                                  parent.comparators)) and
+                    not self.repeated(parent))
+        return False
+
+    def visit_FunctionDef(self, node):
+        self.result[node] = borrowed = set()
+        # elements are converted through the Python C API, which may not
+        # happen concurrently, nor once the call is over
+        if self.gather(UseOMP, node) or self.gather(YieldPoints, node):
+            return
+        effects = self.argument_effects[node]
+        for i, arg in enumerate(node.args.args):
+            if effects[i]:
+                continue
+            uses = [n for n in ast.walk(node)
+                    if isinstance(n, ast.Name) and n.id == arg.id and
+                    n is not arg]
+            if all(self.borrowable(use) for use in uses):
+                borrowed.add(i)
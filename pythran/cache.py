@@ -0,0 +1,336 @@
+'''
+This module implements the persistent compilation cache: native modules are
+stored under a key that covers everything their content depends on, so that
+compiling the same code again is just a file copy.
+'''
+
+from pythran.config import cfg, init_cfg, make_extension
+from pythran.spec import Spec, spec_to_string
+from pythran.version import __version__
+
+from distutils import sysconfig
+import gast as ast
+import hashlib
+import json
+import logging
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+logger = logging.getLogger('pythran')
+
+_pythonic_digest = None
+_sources_digest = None
+_compiler_versions = {}
+
+# The cache directory may be shared with other programs, so only files named
+# like the cache's own are ever listed or removed: modules stored as
+# xx/<sha256> and precompiled headers under pch/<sha256>/.
+_key_pattern = re.compile(r'^[0-9a-f]{64}$')
+_prefix_pattern = re.compile(r'^[0-9a-f]{2}$')
+_tmp_suffix = '.tmp'
+pch_header = 'pythran_pch.hpp'
+
+# environment variables distutils forwards to the compiler and the linker
+_build_environment = ('CC', 'CXX', 'CPPFLAGS', 'CFLAGS', 'CXXFLAGS',
+                      'LDSHARED', 'LDFLAGS')
+
+
+def _config(config_args=None):
+    cfgp = init_cfg('pythran.cfg',
+                    'pythran-{}.cfg'.format(sys.platform),
+                    '.pythranrc',
+                    config_args)
+    return cfgp
+
+
+def cache_directory(config_args=None):
+    '''Directory holding the cache, None if the cache is disabled.'''
+    cfgp = _config(config_args)
+    if not cfgp.has_section('cache'):
+        return None
+    if cfgp.getint('cache', 'max_size') <= 0:
+        return None
+    directory = cfgp.get('cache', 'directory')
+    if not directory:
+        directory = os.path.join(os.environ.get('XDG_CACHE_HOME',
+                                                os.path.join('~', '.cache')),
+                                 'pythran')
+    return os.path.expanduser(directory)
+
+
+def _max_size(config_args=None):
+    return _config(config_args).getint('cache', 'max_size') * 2 ** 20
+
+
+def pythonic_hash():
+    '''Digest of the pythonic headers, computed once per process.'''
+    global _pythonic_digest
+    if _pythonic_digest is None:
+        digest = hashlib.sha256()
+        root = os.path.join(os.path.dirname(__file__), 'pythonic')
+        for dirpath, dirnames, filenames in os.walk(root):
+            dirnames.sort()
+            for filename in sorted(filenames):
+                path = os.path.join(dirpath, filename)
+                digest.update(os.path.relpath(path, root).encode('utf-8'))
+                with open(path, 'rb') as header:
+                    digest.update(header.read())
+        _pythonic_digest = digest.hexdigest()
+    return _pythonic_digest
+
+
+def _sources_hash():
+    '''Digest of the pythran sources, so that a modified compiler misses the
+    cache even if its version is unchanged.'''
+    global _sources_digest
+    if _sources_digest is None:
+        digest = hashlib.sha256()
+        root = os.path.dirname(__file__)
+        for dirpath, dirnames, filenames in os.walk(root):
+            # headers are covered by pythonic_hash
+            dirnames[:] = sorted(d for d in dirnames
+                                 if d not in ('pythonic', 'tests'))
+            for filename in sorted(filenames):
+                if not filename.endswith('.py'):
+                    continue
+                path = os.path.join(dirpath, filename)
+                digest.update(os.path.relpath(path, root).encode('utf-8'))
+                with open(path, 'rb') as source:
+                    digest.update(source.read())
+        _sources_digest = digest.hexdigest()
+    return _sources_digest
+
+
+def compiler_version(cxx):
+    '''Output of `cxx --version`, so that compiler upgrades miss the cache.'''
+    if cxx not in _compiler_versions:
+        try:
+            output = subprocess.check_output([cxx, '--version'],
+                                             stderr=subprocess.STDOUT)
+        except (OSError, subprocess.CalledProcessError):
+            output = b''
+        _compiler_versions[cxx] = output.decode('utf-8', 'replace')
+    return _compiler_versions[cxx]
+
+
+def _imported_sources(code, module_dir, seen):
+    '''Content of the user modules imported by `code`, recursively, located
+    the same way HandleImport does.'''
+    try:
+        tree = ast.parse(code)
+    except SyntaxError:
+        return []
+    sources = []
+    for node in ast.walk(tree):
+        if isinstance(node, ast.Import):
+            imported = [(alias.name, 0) for alias in node.names]
+        elif isinstance(node, ast.ImportFrom) and node.module:
+            imported = [(node.module, node.level)]
+        else:
+            continue
+        for name, level in imported:
+            module_base = name.replace('.', os.path.sep) + '.py'
+            if module_dir is None:
+                module_file = module_base
+            else:
+                module_file = os.path.sep.join([module_dir] +
+                                               ['..'] * (level - 1) +
+                                               [module_base])
+            if module_file in seen or not os.path.isfile(module_file):
+                continue
+            seen.add(module_file)
+            with open(module_file) as fd:
+                source = fd.read()
+            sources.append((name, source))
+            sources.extend(_imported_sources(source, module_dir, seen))
+    return sources
+
+
+def _specs_key(specs):
+    if specs is None:
+        return None
+    if isinstance(specs, dict):
+        specs = Spec(specs, {})
+    return ([[spec_to_string(name, signature) for signature in signatures]
+             for name, signatures in sorted(specs.functions.items())],
+            [spec_to_string(name, signature)
+             for name, signature in sorted(specs.capsules.items())])
+
+
+def make_key(module_name, code, specs, optimizations, module_dir, kwargs):
+    '''Hash of everything the native module depends on.'''
+    # same build options as the PythranExtension compile_cxxfile creates
+    extension = make_extension(python=True,
+                               **{k: v for k, v in kwargs.items()
+                                  if k != 'keep_temp'})
+    cxx = extension.get('cxx') or sysconfig.get_config_var('CXX') or 'c++'
+    # the module name prefixes every exported symbol
+    content = {
+        'module_name': module_name,
+        'code': code,
+        'imports': _imported_sources(code, module_dir, set()),
+        'specs': _specs_key(specs),
+        'optimizations': optimizations,
+        # code generation options, e.g. borrowed_arguments
+        'pythran_options': dict(cfg.items('pythran')),
+        'extension': extension,
+        'environment': {name: os.environ.get(name)
+                        for name in _build_environment},
+        'compiler': compiler_version(cxx.split()[0]),
+        'pythonic': pythonic_hash(),
+        'pythran': [__version__, _sources_hash()],
+        'python': sys.version,
+        'suffix': sysconfig.get_config_var('EXT_SUFFIX'),
+    }
+    serialized = json.dumps(content, sort_keys=True, default=repr)
+    return hashlib.sha256(serialized.encode('utf-8')).hexdigest()
+
+
+def _entry_path(directory, key):
+    return os.path.join(directory, key[:2], key)
+
+
+def lookup(key, config_args=None):
+    '''Path to the cached module for `key`, or None.'''
+    directory = cache_directory(config_args)
+    if directory is None:
+        return None
+    path = _entry_path(directory, key)
+    if not os.path.isfile(path):
+        return None
+    # eviction removes the least recently used entries first
+    try:
+        os.utime(path, None)
+    except OSError:
+        pass
+    return path
+
+
+def store(key, module_path, config_args=None):
+    '''Adds a copy of `module_path` to the cache under `key`.'''
+    directory = cache_directory(config_args)
+    if directory is None:
+        return
+    path = _entry_path(directory, key)
+    try:
+        if not os.path.isdir(os.path.dirname(path)):
+            os.makedirs(os.path.dirname(path))
+        # write then rename, so that concurrent builds never see a partial
+        # entry
+        fd, tmp = tempfile.mkstemp(dir=os.path.dirname(path),
+                                   prefix=key + '.', suffix=_tmp_suffix)
+        with os.fdopen(fd, 'wb') as dest:
+            with open(module_path, 'rb') as src:
+                shutil.copyfileobj(src, dest)
+        os.rename(tmp, path)
+    except (IOError, OSError) as e:
+        logger.warn("Failed to store compiled module in cache: " + str(e))
+        return
+    evict(_max_size(config_args), directory)
+
+
+def _owned_files(directory):
+    '''Paths of the files the cache created in `directory`, along with
+    whether they are entries, i.e. modules or precompiled headers, rather
+    than headers to precompile or leftovers of interrupted writes.'''
+    if not os.path.isdir(directory):
+        return
+    for prefix in sorted(os.listdir(directory)):
+        subdir = os.path.join(directory, prefix)
+        if not os.path.isdir(subdir):
+            continue
+        if prefix == 'pch':
+            for key in sorted(os.listdir(subdir)):
+                keydir = os.path.join(subdir, key)
+                if not _key_pattern.match(key) or not os.path.isdir(keydir):
+                    continue
+                for filename in sorted(os.listdir(keydir)):
+                    if filename in (pch_header + '.gch',
+                                    pch_header + '.pch'):
+                        yield os.path.join(keydir, filename), True
+                    elif (filename == pch_header or
+                          filename.startswith('tmp')):
+                        yield os.path.join(keydir, filename), False
+        elif _prefix_pattern.match(prefix):
+            for filename in sorted(os.listdir(subdir)):
+                key = filename.split('.')[0]
+                if not _key_pattern.match(key) or not key.startswith(prefix):
+                    continue
+                if key == filename:
+                    yield os.path.join(subdir, filename), True
+                elif filename.endswith(_tmp_suffix):
+                    yield os.path.join(subdir, filename), False
+
+
+def _entries(directory):
+    entries = []
+    for path, is_entry in _owned_files(directory):
+        if not is_entry:
+            continue
+        try:
+            stat = os.stat(path)
+        except OSError:
+            continue
+        entries.append((stat.st_mtime, stat.st_size, path))
+    return entries
+
+
+def evict(max_size, directory):
+    '''Removes least recently used entries until the cache fits `max_size`
+    bytes.'''
+    entries = sorted(_entries(directory))
+    total = sum(size for _, size, _ in entries)
+    for _, size, path in entries:
+        if total <= max_size:
+            break
+        try:
+            os.remove(path)
+        except OSError:
+            continue
+        total -= size
+
+
+def info(config_args=None):
+    '''Human readable description of the cache state.'''
+    directory = cache_directory(config_args)
+    if directory is None:
+        return "pythran cache is disabled"
+    entries = _entries(directory) if os.path.isdir(directory) else []
+    return ("pythran cache: {}\n"
+            "{} entries, {:.1f} MiB used out of {:.0f} MiB"
+            .format(directory, len(entries),
+                    sum(size for _, size, _ in entries) / 2. ** 20,
+                    _max_size(config_args) / 2. ** 20))
+
+
+def clear(config_args=None):
+    '''Removes every cached module and precompiled header, leaving any other
+    file in the cache directory alone.'''
+    directory = cache_directory(config_args)
+    if directory is None:
+        return
+    for path, _ in list(_owned_files(directory)):
+        try:
+            os.remove(path)
+        except OSError:
+            pass
+    # then the directories of the cache that are left empty
+    pch = os.path.join(directory, 'pch')
+    subdirs = []
+    if os.path.isdir(pch):
+        subdirs.extend(os.path.join(pch, key) for key in os.listdir(pch)
+                       if _key_pattern.match(key))
+        subdirs.append(pch)
+    if os.path.isdir(directory):
+        subdirs.extend(os.path.join(directory, prefix)
+                       for prefix in os.listdir(directory)
+                       if _prefix_pattern.match(prefix))
+    for subdir in subdirs:
+        try:
+            os.rmdir(subdir)
+        except OSError:
+            pass
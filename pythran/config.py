@@ -167,6 +167,8 @@ def make_extension(python, **extra):
         cxx = compiler()
     if cxx is not None:
         extension['cxx'] = cxx
+    if cfg.has_option('compiler', 'pch'):
+        extension['pch'] = cfg.getboolean('compiler', 'pch')
 
     for k, w in extra.items():
         extension[k].extend(w)
@@ -199,7 +201,10 @@ def make_extension(python, **extra):
                             "Defaulting to 'blas'")
                 user_blas = 'blas'
 
-        if user_blas != 'pythran-openblas':
+        if user_blas == 'none':
+            # in-tree kernels, no library to link
+            extension['define_macros'].append('PYTHRAN_BLAS_NONE')
+        elif user_blas != 'pythran-openblas':
             numpy_blas = numpy_sys.get_info(user_blas)
             # required to cope with atlas missing extern "C"
             extension['define_macros'].append('PYTHRAN_BLAS_{}'
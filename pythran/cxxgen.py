@@ -29,7 +29,9 @@ Generator for C/C++.
 
 from __future__ import division
 
+from itertools import groupby
 from textwrap import dedent
+import re
 from pythran.tables import pythran_ward
 from pythran.spec import signatures_to_string
 
@@ -437,6 +439,67 @@ class Namespace(Block):
 # SOFTWARE.
 #
 
+def conversion_family(ctype):
+    """
+    Family of the Python objects converted to *ctype*: objects of different
+    families never convert to the same types. None if unknown.
+
+    >>> conversion_family('npy_int8') == conversion_family('long')
+    True
+    >>> conversion_family('double') == conversion_family('float')
+    False
+    """
+    scalars = {'bool': 'bool',
+               'long': 'int',
+               'double': 'float',
+               'float': 'float32',
+               'long double': 'float128',
+               'std::complex<double>': 'complex',
+               'std::complex<float>': 'complex64',
+               'std::complex<long double>': 'complex256',
+               'pythonic::types::str': 'str',
+               'pythonic::types::none_type': 'None',
+               'pythonic::types::slice': 'slice'}
+    if ctype in scalars:
+        return scalars[ctype]
+    if ctype.startswith('npy_'):
+        return 'int'
+    containers = (('pythonic::types::list<', 'list'),
+                  ('pythonic::types::borrowed_list<', 'list'),
+                  ('pythonic::types::set<', 'set'),
+                  ('pythonic::types::dict<', 'dict'),
+                  ('pythonic::types::borrowed_dict<', 'dict'),
+                  ('decltype(pythonic::types::make_tuple(', 'tuple'))
+    for prefix, family in containers:
+        if ctype.startswith(prefix):
+            return family
+    arrays = ('pythonic::types::ndarray<', 'pythonic::types::numpy_texpr<',
+              'pythonic::types::numpy_gexpr<')
+    dtype = re.search(r'ndarray<([^,]+),', ctype)
+    if ctype.startswith(arrays) and dtype:
+        family = conversion_family(dtype.group(1))
+        return family and family + '[]'
+    return None
+
+
+def dispatch_tree(overloads, position, leaf):
+    """
+    Tests the argument at *position* against each of *overloads*, a list of
+    (index, ctypes) with the same arity, in order. Consecutive overloads
+    expecting the same type share the test. *leaf* formats the call to the
+    selected overload.
+    """
+    index, ctypes = overloads[0]
+    if position == len(ctypes):
+        return leaf(index)
+    tests = []
+    for ctype, run in groupby(overloads, key=lambda o: o[1][position]):
+        tests.append('if(is_convertible<{}>(args_obj[{}])) {{\n{}\n}}'
+                     .format(ctype, position,
+                             dispatch_tree(list(run), position + 1, leaf)))
+    return '\n'.join(tests)
+
+
 class PythonModule(object):
     '''
     Wraps the creation of a Pythran module wrapped a Python native Module
@@ -454,6 +517,12 @@ class PythonModule(object):
         self.capsules = []
         self.python_implems = []
         self.wrappers = []
+        self.calls = []
+        # (function, wrapper fields, name) for each exported specialization
+        self.specializations = []
+        # exported functions that update a global state of the runtime, e.g.
+        # a random generator, of which each translation unit has its own copy
+        self.stateful = set()
         self.docstrings = docstrings
 
         self.metadata = metadata
@@ -499,6 +568,7 @@ class PythonModule(object):
         args_unboxing = []  # turns PyObject to c++ object
         args_checks = []  # check if the above conversion is valid
         wrapper_name = pythran_ward + 'wrap_' + func.fdecl.name
+        call_name = pythran_ward + 'call_' + func.fdecl.name
 
         for i, t in enumerate(ctypes):
             args_unboxing.append('from_python<{}>(args_obj[{}])'.format(t, i))
@@ -521,20 +591,31 @@ class PythonModule(object):
                 }}
             }}''')
 
-        self.wrappers.append(
-            wrapper.format(name=func.fdecl.name,
-                           size=len(ctypes),
-                           fmt="O" * len(ctypes),
-                           objs=''.join(', &args_obj[%d]' % i
-                                          for i in range(len(ctypes))),
-                           args=', '.join(args_unboxing),
-                           checks=' && '.join(args_checks) or '1',
-                           wname=wrapper_name,
-                           keywords=keywords,
-                           )
-        )
-
-        func_descriptor = wrapper_name, ctypes, signature
+        fields = dict(name=func.fdecl.name,
+                      size=len(ctypes),
+                      fmt="O" * len(ctypes),
+                      objs=''.join(', &args_obj[%d]' % i
+                                   for i in range(len(ctypes))),
+                      args=', '.join(args_unboxing),
+                      checks=' && '.join(args_checks) or '1',
+                      wname=wrapper_name,
+                      cname=call_name,
+                      keywords=keywords,
+                      )
+        self.wrappers.append(wrapper.format(**fields))
+        # entry point of the METH_FASTCALL dispatcher, once the arguments
+        # are known to match
+        call = dedent('''
+            static PyObject *
+            {cname}(PyObject *const *args_obj)
+            {{
+                return to_python({name}({args}));
+            }}''')
+        self.calls.append(call.format(**fields))
+        self.specializations.append((func, fields, name))
+
+        argnames = [arg.name for arg in arg_decls]
+        func_descriptor = wrapper_name, ctypes, signature, call_name, argnames
         self.functions.setdefault(name, []).append(func_descriptor)
 
     def add_global_var(self, name, init):
@@ -542,27 +623,19 @@ class PythonModule(object):
         self.python_implems.append(Assign('static PyObject* ' + name,
                                    'to_python({})'.format(init)))
 
-    def __str__(self):
-        """Generate (i.e. yield) the source code of the
-        module line-by-line.
+    def dispatchers(self, try_overload):
+        """
+        Method table entries and overload dispatchers of the exported
+        functions. *try_overload* formats the call to the wrapper of a given
+        specialization.
         """
         themethods = []
-        theextraobjects = []
         theoverloads = []
-        for vname in self.global_vars:
-            theextraobjects.append(
-                'PyModule_AddObject(theModule, "{0}", {0});'.format(vname))
-
         for fname, overloads in self.functions.items():
             tryall = []
             signatures = []
-            for overload, ctypes, signature in overloads:
-                try_ = dedent("""
-                    if(PyObject* obj = {name}(self, args, kw))
-                        return obj;
-                    PyErr_Clear();
-                    """.format(name=overload))
-                tryall.append(try_)
+            for overload, _, signature, _, _ in overloads:
+                tryall.append(try_overload.format(name=overload))
                 signatures.append(signature)
 
             candidates = signatures_to_string(fname, signatures)
@@ -591,12 +664,108 @@ class PythonModule(object):
             themethod = dedent('''{{
                 "{name}",
                 (PyCFunction){wname},
-                METH_VARARGS | METH_KEYWORDS,
+                PYTHRAN_METH_ARGS,
                 {doc}}}'''.format(name=fname,
                                   wname=wrapper_name,
                                   doc=fdoc))
             themethods.append(themethod)
             theoverloads.append(candidate)
+        return themethods, theoverloads
+
+    def fastcall_dispatchers(self, call_overload):
+        """
+        METH_FASTCALL dispatchers of the exported functions. Arguments are
+        sorted once, then the overload is selected by their count and a
+        decision tree on their types. The overload matched by the previous
+        call is tried first, provided no earlier overload can accept the
+        same arguments. *call_overload* formats the call to the entry point
+        of a given specialization.
+        """
+        theoverloads = []
+        for fname, overloads in self.functions.items():
+            keywords = max((o[4] for o in overloads), key=len)
+            signatures = [o[2] for o in overloads]
+            candidates = signatures_to_string(fname, signatures)
+
+            arities = []
+            for _, ctypes, _, _, _ in overloads:
+                if len(ctypes) not in arities:
+                    arities.append(len(ctypes))
+
+            # overloads that are the first match whenever they match
+            cacheable = set()
+            for k, (_, ctypes, _, _, _) in enumerate(overloads):
+                if len(overloads) > 1 and all(
+                        len(other) != len(ctypes) or
+                        any(conversion_family(t) and conversion_family(u) and
+                            conversion_family(t) != conversion_family(u)
+                            for t, u in zip(other, ctypes))
+                        for _, other, _, _, _ in overloads[:k]):
+                    cacheable.add(k)
+
+            def leaf(k):
+                call = 'return {};'.format(
+                    call_overload.format(name=overloads[k][3]))
+                if k in cacheable:
+                    return 'last = {};\n{}'.format(k, call)
+                return call
+
+            cases = []
+            for arity in arities:
+                same_arity = [(k, o[1]) for k, o in enumerate(overloads)
+                              if len(o[1]) == arity]
+                cases.append('case {}:\n{}\nbreak;'.format(
+                    arity, dispatch_tree(same_arity, 0, leaf)))
+
+            cache = []
+            for k in sorted(cacheable):
+                ctypes = overloads[k][1]
+                checks = ''.join(' && is_convertible<{}>(args_obj[{}])'
+                                 .format(t, i) for i, t in enumerate(ctypes))
+                cache.append('case {}:\nif(count == {}{})\nreturn {};\n'
+                             'break;'.format(
+                                 k, len(ctypes), checks,
+                                 call_overload.format(name=overloads[k][3])))
+            if cache:
+                cache = ['static long last = -1;', 'switch(last) {'] + \
+                    cache + ['}']
+
+            candidate = dedent('''
+            static PyObject *
+            {wname}(PyObject *self, PyObject *const *args, Py_ssize_t nargs,
+                    PyObject *kwnames)
+            {{
+                static char const* keywords[] = {{{keywords} nullptr}};
+                PyObject* args_obj[{size}+1];
+                long count = pythonic::python::fastcall_arguments(
+                    args_obj, keywords, {size}, args, nargs, kwnames);
+                return pythonic::handle_python_exception([&]() -> PyObject* {{
+                {cache}
+                switch(count) {{
+                {cases}
+                }}
+                return pythonic::python::raise_invalid_argument(
+                               "{name}", {candidates}, args, nargs, kwnames);
+                }});
+            }}
+            ''').format(name=fname,
+                         wname=pythran_ward + 'wrapall_' + fname,
+                         keywords=''.join('"{}", '.format(k)
+                                          for k in keywords),
+                         size=len(keywords),
+                         cache='\n'.join(cache),
+                         cases='\n'.join(cases),
+                         candidates=self.splitstring(
+                             candidates.replace('\n', '\\n')))
+            theoverloads.append(candidate)
+        return theoverloads
+
+    def module_init(self, themethods):
+        """Method table and initialization function of the module."""
+        theextraobjects = []
+        for vname in self.global_vars:
+            theextraobjects.append(
+                'PyModule_AddObject(theModule, "{0}", {0});'.format(vname))
 
         for ptrname, sig in self.capsules:
             capsule = '''
@@ -607,6 +776,11 @@ class PythonModule(object):
             theextraobjects.append(capsule)
 
         methods = dedent('''
+            #ifdef PYTHRAN_FASTCALL
+            #define PYTHRAN_METH_ARGS METH_FASTCALL | METH_KEYWORDS
+            #else
+            #define PYTHRAN_METH_ARGS METH_VARARGS | METH_KEYWORDS
+            #endif
             static PyMethodDef Methods[] = {{
                 {methods}
                 {{NULL, NULL, 0, NULL}}
@@ -668,17 +842,152 @@ class PythonModule(object):
             '''.format(name=self.name,
                        extraobjects='\n'.join(theextraobjects),
                        **self.metadata))
+        return [Line(methods), Line(module)]
+
+    def __str__(self):
+        """Generate (i.e. yield) the source code of the
+        module line-by-line.
+        """
+        themethods, theoverloads = self.dispatchers(dedent("""
+            if(PyObject* obj = {name}(self, args, kw))
+                return obj;
+            PyErr_Clear();
+            """))
+        thefastoverloads = self.fastcall_dispatchers("{name}(args_obj)")
 
         body = (self.preamble +
                 self.includes +
                 self.implems +
                 [Line('#ifdef ENABLE_PYTHON_MODULE')] +
                 self.python_implems +
+                [Line('#ifdef PYTHRAN_FASTCALL')] +
+                [Line(code) for code in self.calls + thefastoverloads] +
+                [Line('#else')] +
                 [Line(code) for code in self.wrappers + theoverloads] +
-                [Line(methods), Line(module), Line('#endif')])
+                [Line('#endif')] +
+                self.module_init(themethods) +
+                [Line('#endif')])
 
         return "\n".join(Module(body).generate())
 
+    def split(self, count):
+        """
+        Generate the module as a header shared by several translation units:
+        one for the module definition, and up to *count* for the exported
+        specializations, spread by contiguous groups. Specializations of
+        stateful functions stay with the module definition, so that they all
+        update the same state.
+
+        Returns a list of (file name, source code), the header first.
+        """
+        name = self.name
+        namespace = pythran_ward + name + '_split'
+        specialized = [func for func, _, _ in self.specializations]
+
+        # each translation unit gets its own copy of the module functions,
+        # but they all share the numpy API table
+        guard = namespace.upper() + '_HPP'
+        header = ([Line('#ifndef ' + guard), Define(guard, ''),
+                   Define('PY_ARRAY_UNIQUE_SYMBOL',
+                          pythran_ward + name + '_ARRAY_API')] +
+                  self.preamble +
+                  [Namespace('', [incl]) if isinstance(incl, Namespace)
+                   else incl
+                   for incl in self.includes] +
+                  [Line('#endif')])
+
+        # exceptions do not cross translation units, so wrappers turn them
+        # into Python errors, and only report an error if the call failed
+        wrapper = dedent('''
+            PyObject *
+            {wname}(PyObject *self, PyObject *args, PyObject *kw)
+            {{
+                PyObject* args_obj[{size}+1];
+                char const* keywords[] = {{{keywords} nullptr}};
+                if(! PyArg_ParseTupleAndKeywords(args, kw, "{fmt}",
+                                                 (char**)keywords {objs})) {{
+                    PyErr_Clear();
+                    return nullptr;
+                }}
+                if(! ({checks}))
+                    return nullptr;
+                return pythonic::handle_python_exception([&]() -> PyObject* {{
+                    return to_python({name}({args}));
+                }});
+            }}''')
+        call = dedent('''
+            PyObject *
+            {cname}(PyObject *const *args_obj)
+            {{
+                return pythonic::handle_python_exception([&]() -> PyObject* {{
+                    return to_python({name}({args}));
+                }});
+            }}''')
+        themethods, theoverloads = self.dispatchers(dedent("""
+            if(PyObject* obj = {namespace}::{{name}}(self, args, kw))
+                return obj;
+            if(PyErr_Occurred())
+                return nullptr;
+            """.format(namespace=namespace)))
+        thefastoverloads = self.fastcall_dispatchers(
+            namespace + "::{name}(args_obj)")
+        declarations = [Line('#ifdef PYTHRAN_FASTCALL')]
+        declarations.extend(Line('PyObject *{}(PyObject *const *args_obj);'
+                                 .format(fields['cname']))
+                            for _, fields, _ in self.specializations)
+        declarations.append(Line('#else'))
+        declarations.extend(Line('PyObject *{}(PyObject *self, PyObject *args,'
+                                 ' PyObject *kw);'.format(fields['wname']))
+                            for _, fields, _ in self.specializations)
+        declarations.append(Line('#endif'))
+
+        def definitions(group):
+            contents = []
+            for func, fields, _ in group:
+                contents.append(func)
+                contents.extend([Line('#ifdef PYTHRAN_FASTCALL'),
+                                 Line(call.format(**fields)),
+                                 Line('#else'),
+                                 Line(wrapper.format(**fields)),
+                                 Line('#endif')])
+            return contents
+
+        stateful = [spec for spec in self.specializations
+                    if spec[2] in self.stateful]
+        spread = [spec for spec in self.specializations
+                  if spec[2] not in self.stateful]
+
+        main = ([Include(name + '.hpp', system=False)] +
+                [implem for implem in self.implems
+                 if implem not in specialized] +
+                [Line('#ifdef ENABLE_PYTHON_MODULE')] +
+                [implem for implem in self.python_implems
+                 if implem not in specialized] +
+                [Namespace(namespace, declarations + definitions(stateful))] +
+                [Line('#ifdef PYTHRAN_FASTCALL')] +
+                [Line(code) for code in thefastoverloads] +
+                [Line('#else')] +
+                [Line(code) for code in theoverloads] +
+                [Line('#endif')] +
+                self.module_init(themethods) +
+                [Line('#endif')])
+
+        files = [(name + '.hpp', header), (name + '.cpp', main)]
+
+        total = len(spread)
+        count = min(count, total)
+        for i in range(count):
+            group = spread[i * total // count: (i + 1) * total // count]
+            part = [Define('NO_IMPORT_ARRAY', ''),
+                    Include(name + '.hpp', system=False),
+                    Line('#ifdef ENABLE_PYTHON_MODULE'),
+                    Namespace(namespace, definitions(group)),
+                    Line('#endif')]
+            files.append(('{}_{}.cpp'.format(name, i), part))
+
+        return [(filename, "\n".join(Module(body).generate()))
+                for filename, body in files]
+
 
 class CompilationUnit(object):
 
@@ -4,16 +4,56 @@ This modules contains a distutils extension mechanism for Pythran
 '''
 
 import pythran.config as cfg
+from pythran import cache
+from pythran.version import __version__
 
 from collections import defaultdict, Iterable
+from multiprocessing.pool import ThreadPool
+import copy
+import hashlib
+import json
+import logging
+import multiprocessing
 import os.path
 import os
+import subprocess
 import sys
+import tempfile
+import threading
+import time
 
+from distutils import log
+from distutils.ccompiler import gen_preprocess_options
 from distutils.command.build_ext import build_ext as LegacyBuildExt
 
 from numpy.distutils.extension import Extension
 
+logger = logging.getLogger('pythran')
+
+_pythonic_mtimes = []
+# extensions built concurrently share their precompiled header
+_pch_lock = threading.Lock()
+
+
+def _pythonic_mtime():
+    '''Modification time of the most recent pythonic header.'''
+    if not _pythonic_mtimes:
+        root = os.path.join(os.path.dirname(__file__), 'pythonic')
+        _pythonic_mtimes.append(max(
+            os.path.getmtime(os.path.join(dirpath, filename))
+            for dirpath, _, filenames in os.walk(root)
+            for filename in filenames))
+    return _pythonic_mtimes[0]
+
+
+def _translate(translation):
+    '''Translates a pythran source to C++, returns the time it took.'''
+    import pythran.toolchain as tc
+    source, output_file, module_name = translation
+    start = time.time()
+    tc.compile_pythranfile(source, output_file, module_name, cpponly=True)
+    return time.time() - start
+
 
 class PythranBuildExt(LegacyBuildExt, object):
     """Subclass of `distutils.command.build_ext.build_ext` which is required to
@@ -21,7 +61,138 @@ class PythranBuildExt(LegacyBuildExt, object):
     subclassed if you want to combine with another build_ext class (NumPy,
     Cython implementations).
 
+    With build_ext's --parallel option, independent extensions are built
+    concurrently: Python to C++ translations in separate processes, then C++
+    compilations in separate threads.
+
     """
+    def jobs(self):
+        '''Number of extensions built concurrently.'''
+        # build_ext --parallel, python >= 3.5
+        parallel = getattr(self, 'parallel', None)
+        if parallel is True:
+            return multiprocessing.cpu_count()
+        return int(parallel or 1)
+
+    def build_extensions(self):
+        jobs = min(self.jobs(), len(self.extensions))
+        if jobs < 2:
+            return super(PythranBuildExt, self).build_extensions()
+
+        self.check_extensions_list(self.extensions)
+        times = defaultdict(lambda: [0., 0.])
+
+        # translation is pure python, hence separate processes
+        translations = [(ext.name, translation)
+                        for ext in self.extensions
+                        if isinstance(ext, PythranExtension)
+                        for translation in ext.pending_translations()]
+        if translations:
+            pool = multiprocessing.Pool(min(jobs, len(translations)))
+            try:
+                elapsed = pool.map(_translate,
+                                   [translation
+                                    for _, translation in translations])
+            finally:
+                pool.close()
+                pool.join()
+            for (name, _), duration in zip(translations, elapsed):
+                times[name][0] += duration
+
+        # compilers mostly wait for their subprocess, threads are enough
+        def build(ext):
+            # build_extension customizes the compiler for each extension
+            builder = copy.copy(self)
+            builder.compiler = copy.copy(self.compiler)
+            for key, value in vars(builder.compiler).items():
+                if isinstance(value, list):
+                    setattr(builder.compiler, key, list(value))
+            start = time.time()
+            builder.build_extension(ext)
+            return time.time() - start
+
+        pool = ThreadPool(jobs)
+        try:
+            elapsed = pool.map(build, self.extensions)
+        finally:
+            pool.close()
+            pool.join()
+        for ext, duration in zip(self.extensions, elapsed):
+            times[ext.name][1] += duration
+
+        log.info("{:<40}{:>14}{:>14}".format('extension', 'translation',
+                                               'compilation'))
+        for name, (translation, compilation) in sorted(times.items()):
+            log.info("{:<40}{:>13.1f}s{:>13.1f}s".format(name, translation,
+                                                         compilation))
+
+    def build_pch(self, ext):
+        """Precompiles the pythonic core headers with the very flags `ext` is
+        built with, and returns the header to force-include, or None when the
+        compiler does not support it."""
+        # gcc-like compilers only
+        compiler_so = getattr(self.compiler, 'compiler_so', None)
+        if not compiler_so:
+            return None
+
+        # same preprocessor options as build_ext and CCompiler.compile
+        macros = list(self.compiler.macros) + list(ext.define_macros)
+        macros.extend((undef,) for undef in ext.undef_macros)
+        include_dirs = list(self.compiler.include_dirs) + ext.include_dirs
+        command = (list(compiler_so) +
+                   gen_preprocess_options(macros, include_dirs) +
+                   list(ext.extra_compile_args))
+
+        version = cache.compiler_version(command[0])
+        content = [command, version, cache.pythonic_hash(), __version__]
+        # gcc looks for header.gch, clang for header.pch
+        if 'clang' in version:
+            suffix = '.pch'
+            # clang also rejects a pch older than any header it contains
+            content.append(_pythonic_mtime())
+        else:
+            suffix = '.gch'
+        key = hashlib.sha256(json.dumps(content).encode('utf-8'))
+
+        # shared across builds when the compilation cache is enabled
+        directory = cache.cache_directory(ext.config)
+        if directory is None:
+            directory = self.build_temp
+        directory = os.path.join(directory, 'pch', key.hexdigest())
+        header = os.path.join(directory, cache.pch_header)
+        pch = header + suffix
+
+        if os.path.isfile(header) and os.path.isfile(pch):
+            try:
+                os.utime(pch, None)
+            except OSError:
+                pass
+            return header
+
+        tmp = None
+        try:
+            if not os.path.isdir(directory):
+                os.makedirs(directory)
+            # never rewritten: clang checks the header is older than its pch
+            if not os.path.isfile(header):
+                fd, tmp = tempfile.mkstemp(dir=directory)
+                with os.fdopen(fd, 'w') as out:
+                    out.write('#include "pythonic/pch.hpp"\n')
+                os.rename(tmp, header)
+            # concurrent builds never see a partial pch
+            fd, tmp = tempfile.mkstemp(dir=directory, suffix=suffix)
+            os.close(fd)
+            logger.info("Building precompiled header: " + pch)
+            subprocess.check_call(command + ['-x', 'c++-header', header,
+                                             '-o', tmp])
+            os.rename(tmp, pch)
+        except (OSError, subprocess.CalledProcessError) as e:
+            logger.warn("Failed to build precompiled header: " + str(e))
+            if tmp and os.path.exists(tmp):
+                os.remove(tmp)
+            return None
+        return header
+
     def build_extension(self, ext):
         StringTypes = (str, unicode) if sys.version_info[0] == 2 else (str,)
 
@@ -88,9 +259,38 @@ class PythranBuildExt(LegacyBuildExt, object):
                 for i in archs['i386']:
                     self.compiler.compiler_so[i] = 'x86_64'
 
+        # translation units of a split module are independent
+        compile = self.compiler.compile
+        concurrent = len(ext.sources) > 1
+        if concurrent:
+            def compile_concurrently(sources, *args, **kwargs):
+                pool = ThreadPool(min(len(sources),
+                                      multiprocessing.cpu_count()))
+                try:
+                    objects = pool.map(lambda source: compile([source],
+                                                              *args,
+                                                              **kwargs),
+                                       sources)
+                finally:
+                    pool.close()
+                    pool.join()
+                return [obj for objs in objects for obj in objs]
+            self.compiler.compile = compile_concurrently
+
+        extra_compile_args = ext.extra_compile_args
+        if getattr(ext, 'pch', False):
+            with _pch_lock:
+                pch = self.build_pch(ext)
+            if pch:
+                ext.extra_compile_args = extra_compile_args + ['-include',
+                                                               pch]
+
         try:
             return super(PythranBuildExt, self).build_extension(ext)
         finally:
+            ext.extra_compile_args = extra_compile_args
+            if concurrent:
+                del self.compiler.compile
             # Revert compiler settings
             for key in prev.keys():
                 set_value(self.compiler, key, prev[key])
@@ -107,33 +307,42 @@ class PythranExtension(Extension):
     '''
 
     def __init__(self, name, sources, *args, **kwargs):
+        self.config = kwargs.get('config')
         cfg_ext = cfg.make_extension(python=True, **kwargs)
         self.cxx = cfg_ext.pop('cxx', None)
+        self.pch = cfg_ext.pop('pch', False)
         self._sources = sources
         Extension.__init__(self, name, sources, *args, **cfg_ext)
         self.__dict__.pop("sources", None)
 
-    @property
-    def sources(self):
-        import pythran.toolchain as tc
-        cxx_sources = []
+    def pending_translations(self):
+        '''(source, output_file, module_name) for each .py source whose C++
+        translation is missing or outdated.'''
+        # get the last name in the path
+        if '.' in self.name:
+            module_name = os.path.splitext(self.name)[-1][1:]
+        else:
+            module_name = self.name
+        pending = []
         for source in self._sources:
             base, ext = os.path.splitext(source)
             if ext != '.py':
-                cxx_sources.append(source)
                 continue
             output_file = base + '.cpp'  # target name
+            if os.path.exists(source) and (
+                    not os.path.exists(output_file) or
+                    os.path.getmtime(output_file) < os.path.getmtime(source)):
+                pending.append((source, output_file, module_name))
+        return pending
 
-            if os.path.exists(source) and (not os.path.exists(output_file)
-               or os.stat(output_file) < os.stat(source)):
-                # get the last name in the path
-                if '.' in self.name:
-                    module_name = os.path.splitext(self.name)[-1][1:]
-                else:
-                    module_name = self.name
-                tc.compile_pythranfile(source, output_file,
-                                       module_name, cpponly=True)
-            cxx_sources.append(output_file)
+    @property
+    def sources(self):
+        for translation in self.pending_translations():
+            _translate(translation)
+        cxx_sources = []
+        for source in self._sources:
+            base, ext = os.path.splitext(source)
+            cxx_sources.append(base + '.cpp' if ext == '.py' else source)
         return cxx_sources
 
     @sources.setter
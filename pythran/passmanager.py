@@ -100,6 +100,18 @@ class ContextManager(object):
         a.attach(self.passmanager, self.ctx)
         return a.run(node)
 
+    def timed_run(self, run, node):
+        """Calls `run' on `node', accounting it to this pass in the pass
+        manager time report, if any."""
+        report = self.passmanager.time_report
+        if report is None:
+            return run(node)
+        report.enter(type(self))
+        try:
+            return run(node)
+        finally:
+            report.leave()
+
 
 
 class Analysis(ContextManager, ast.NodeVisitor):
@@ -118,9 +130,11 @@ class Analysis(ContextManager, ast.NodeVisitor):
     def run(self, node):
         key = node, type(self)
         if key not in self.passmanager._cache:
-            super(Analysis, self).run(node)
+            self.timed_run(super(Analysis, self).run, node)
             self.passmanager._cache[key] = self.result
         else:
+            if self.passmanager.time_report is not None:
+                self.passmanager.time_report.hit(type(self))
             self.result = self.passmanager._cache[key]
         return self.result
 
@@ -183,7 +197,7 @@ class Transformation(ContextManager, ast.NodeTransformer):
 
     def run(self, node):
         """ Apply transformation and dependencies and fix new node location."""
-        n = super(Transformation, self).run(node)
+        n = self.timed_run(super(Transformation, self).run, node)
         if self.update:
             ast.fix_missing_locations(n)
             self.passmanager._cache.clear()
@@ -199,9 +213,10 @@ class PassManager(object):
     '''
     Front end to the pythran pass system.
     '''
-    def __init__(self, module_name, module_dir=None):
+    def __init__(self, module_name, module_dir=None, time_report=None):
         self.module_name = module_name
         self.module_dir = module_dir or os.getcwd()
+        self.time_report = time_report
         self._cache = {}
 
     def gather(self, analysis, node):
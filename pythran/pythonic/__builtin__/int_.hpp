@@ -20,7 +20,7 @@ namespace __builtin__
     }
     int_::type int_::operator()(types::str const &t, long base) const
     {
-      return (*this)(t.c_str(), base);
+      return (*this)(t.get_data().c_str(), base);
     }
 
     template <class T>
@@ -18,7 +18,7 @@ namespace __builtin__
       throw types::TypeError(
           "ord() expected a character, but string of length " +
           std::to_string(v.size()) + " found");
-    return (long)v.chars()[0];
+    return (long)v.raw()[0];
   }
 }
 PYTHONIC_NS_END
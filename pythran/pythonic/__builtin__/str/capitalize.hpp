@@ -20,9 +20,10 @@ namespace __builtin__
         return s;
       else {
         types::str copy = s;
-        copy.chars()[0] = ::toupper(s.chars()[0]);
-        std::transform(s.chars().begin() + 1, s.chars().end(),
-                       copy.chars().begin() + 1, ::tolower);
+        char const *chars = s.raw();
+        copy.chars()[0] = ::toupper(chars[0]);
+        std::transform(chars + 1, chars + s.size(), copy.chars() + 1,
+                       ::tolower);
         return copy;
       }
     }
@@ -16,7 +16,7 @@ namespace __builtin__
 
     bool isalpha(types::str const &s)
     {
-      return !s.empty() && std::all_of(s.chars().begin(), s.chars().end(),
+      return !s.empty() && std::all_of(s.raw(), s.raw() + s.size(),
                                        (int (*)(int))std::isalpha);
     }
   }
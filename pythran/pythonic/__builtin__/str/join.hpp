@@ -25,18 +25,18 @@ namespace __builtin__
 
       std::string out(n, 0);
 
-      auto iter = iterable.chars().begin();
+      char const *iter = iterable.raw(), *end = iter + iterable.size();
       auto oter = out.begin();
-      if (iter != iterable.chars().end()) {
+      if (iter != end) {
         *oter++ = *iter++;
         if (ssize)
-          for (; iter != iterable.chars().end(); ++iter) {
+          for (; iter != end; ++iter) {
             for (auto &&v : s)
-              *oter++ = v.chars()[0];
+              *oter++ = v.raw()[0];
             *oter++ = *iter;
           }
         else
-          std::copy(iter, iterable.chars().end(), oter);
+          std::copy(iter, end, oter);
       }
       return {std::move(out)};
     }
@@ -68,23 +68,19 @@ namespace __builtin__
       auto iter = iterable.begin();
       auto oter = out.begin();
       if (iter != iterable.end()) {
-        auto tmp = *iter;
-        auto const &stmp = tmp.chars();
-        oter = std::copy(stmp.begin(), stmp.end(), oter);
+        types::str const &tmp = *iter;
+        oter = std::copy(tmp.raw(), tmp.raw() + tmp.size(), oter);
         ++iter;
         if (ssize)
           for (; iter != iterable.end(); ++iter) {
-            oter = std::copy(std::begin(s.chars()),
-                             std::begin(s.chars()) + ssize, oter);
-            auto tmp = *iter;
-            auto const &stmp = tmp.chars();
-            oter = std::copy(stmp.begin(), stmp.end(), oter);
+            oter = std::copy(s.raw(), s.raw() + ssize, oter);
+            types::str const &tmp = *iter;
+            oter = std::copy(tmp.raw(), tmp.raw() + tmp.size(), oter);
           }
         else
           for (; iter != iterable.end(); ++iter) {
-            auto tmp = (*iter);
-            auto const &stmp = tmp.chars();
-            oter = std::copy(stmp.begin(), stmp.end(), oter);
+            types::str const &tmp = *iter;
+            oter = std::copy(tmp.raw(), tmp.raw() + tmp.size(), oter);
           }
       }
       return {std::move(out)};
@@ -0,0 +1,33 @@
+#ifndef PYTHONIC_BUILTIN_STR_PARTITION_HPP
+#define PYTHONIC_BUILTIN_STR_PARTITION_HPP
+
+#include "pythonic/include/__builtin__/str/partition.hpp"
+
+#include "pythonic/types/exceptions.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/types/tuple.hpp"
+#include "pythonic/utils/functor.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace __builtin__
+{
+
+  namespace str
+  {
+    types::make_tuple_t<types::str, types::str, types::str>
+    partition(types::str const &self, types::str const &sep)
+    {
+      if (sep.empty())
+        throw types::ValueError("empty separator");
+      long pos = self.find(sep);
+      if (pos == -1)
+        return types::make_tuple(self, types::str(), types::str());
+      else
+        return types::make_tuple(self.substr(0, pos), sep,
+                                 self.substr(pos + sep.size()));
+    }
+  }
+}
+PYTHONIC_NS_END
+#endif
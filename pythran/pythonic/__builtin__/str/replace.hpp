@@ -17,34 +17,28 @@ namespace __builtin__
     types::str replace(types::str const &self, types::str const &old_pattern,
                        types::str const &new_pattern, long count)
     {
-      char const *needle = old_pattern.c_str();
-      char const *new_needle = new_pattern.c_str();
-      char const *new_needle_end = new_needle + new_pattern.size();
-      char const *haystack = self.c_str();
-
-      char const *haystack_next = strstr(haystack, needle);
-      if (!count || !haystack_next) {
-        return {haystack};
-      } else {
-        size_t n =
-            1 + std::max(self.size(), self.size() * (1 + new_pattern.size()) /
-                                          (1 + old_pattern.size()));
-        char *buffer = new char[n];
-        char *iter = buffer;
-        do {
-          iter = std::copy(haystack, haystack_next, iter);
-          iter = std::copy(new_needle, new_needle_end, iter);
-          --count;
-          haystack = haystack_next + old_pattern.size();
-          assert(size_t(iter - buffer) < n);
-        } while (count && (haystack_next = strstr(haystack, needle)));
-
-        std::copy(haystack, self.c_str() + self.size() + 1, iter);
-
-        types::str replaced(buffer);
-        delete[] buffer;
-        return replaced;
-      }
+      long pos = self.find(old_pattern);
+      if (!count || pos < 0)
+        return self;
+      char const *haystack = self.raw();
+      long const n = self.size(), m = old_pattern.size();
+      std::string out;
+      out.reserve(std::max(n, n * (1 + new_pattern.size()) / (1 + m)));
+      long last = 0;
+      do {
+        out.append(haystack + last, pos - last);
+        out.append(new_pattern.raw(), new_pattern.size());
+        last = pos + m;
+        --count;
+        // an empty pattern matches before each character, && at the end
+        if (!m) {
+          if (last == n)
+            return {std::move(out)};
+          out += haystack[last++];
+        }
+      } while (count && (pos = self.find(old_pattern, last)) >= 0);
+      out.append(haystack + last, n - last);
+      return {std::move(out)};
     }
   }
 }
@@ -16,8 +16,7 @@ namespace __builtin__
 
     types::str rstrip(types::str const &self, types::str const &to_del)
     {
-      return {self.chars().begin(),
-              self.chars().begin() + self.find_last_not_of(to_del) + 1};
+      return self.substr(0, self.find_last_not_of(to_del) + 1);
     }
   }
 }
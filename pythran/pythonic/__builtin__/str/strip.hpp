@@ -21,9 +21,7 @@ namespace __builtin__
       if (first == -1)
         return types::str();
       else
-        return types::str(self.chars().begin() + first,
-                          self.chars().begin() + self.find_last_not_of(to_del) +
-                              1);
+        return self.substr(first, self.find_last_not_of(to_del) + 1 - first);
     }
   }
 }
@@ -17,7 +17,7 @@ namespace __builtin__
     types::str upper(types::str const &s)
     {
       types::str copy = s;
-      std::transform(s.chars().begin(), s.chars().end(), copy.chars().begin(),
+      std::transform(s.raw(), s.raw() + s.size(), copy.chars(),
                      ::toupper);
       return copy;
     }
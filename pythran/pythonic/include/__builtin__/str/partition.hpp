@@ -0,0 +1,22 @@
+#ifndef PYTHONIC_INCLUDE_BUILTIN_STR_PARTITION_HPP
+#define PYTHONIC_INCLUDE_BUILTIN_STR_PARTITION_HPP
+
+#include "pythonic/include/types/str.hpp"
+#include "pythonic/include/types/tuple.hpp"
+#include "pythonic/include/utils/functor.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace __builtin__
+{
+
+  namespace str
+  {
+    types::make_tuple_t<types::str, types::str, types::str>
+    partition(types::str const &self, types::str const &sep);
+
+    DEFINE_FUNCTOR(pythonic::__builtin__::str, partition);
+  }
+}
+PYTHONIC_NS_END
+#endif
@@ -0,0 +1,28 @@
+#ifndef PYTHONIC_INCLUDE_NUMPY_ARGPARTITION_HPP
+#define PYTHONIC_INCLUDE_NUMPY_ARGPARTITION_HPP
+
+#include "pythonic/include/utils/functor.hpp"
+#include "pythonic/include/types/ndarray.hpp"
+#include "pythonic/include/types/str.hpp"
+#include "pythonic/include/numpy/partition.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  template <class T, class pS, class K>
+  types::ndarray<long, pS> argpartition(types::ndarray<T, pS> const &a,
+                                        K const &kth, long axis = -1);
+
+  template <class T, class pS, class K>
+  types::ndarray<long, pS> argpartition(types::ndarray<T, pS> const &a,
+                                        K const &kth, long axis,
+                                        types::str const &kind);
+
+  NUMPY_EXPR_TO_NDARRAY0_DECL(argpartition);
+
+  DEFINE_FUNCTOR(pythonic::numpy, argpartition);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -3,13 +3,19 @@
 
 #include "pythonic/include/utils/functor.hpp"
 #include "pythonic/include/types/ndarray.hpp"
+#include "pythonic/include/types/str.hpp"
 
 PYTHONIC_NS_BEGIN
 
 namespace numpy
 {
   template <class T, class pS>
-  types::ndarray<long, pS> argsort(types::ndarray<T, pS> const &a);
+  types::ndarray<long, pS> argsort(types::ndarray<T, pS> const &a,
+                                   long axis = -1);
+
+  template <class T, class pS>
+  types::ndarray<long, pS> argsort(types::ndarray<T, pS> const &a, long axis,
+                                   types::str const &kind);
 
   NUMPY_EXPR_TO_NDARRAY0_DECL(argsort);
 
@@ -4,6 +4,13 @@
 #include "pythonic/include/utils/functor.hpp"
 #include "pythonic/include/types/ndarray.hpp"
 
+// as a macro so that an enlightened user can modify this variable :-)
+// Below this number of taps (or output samples) correlate uses a direct
+// sliding dot product, above it an FFT-based overlap-add.
+#ifndef PYTHRAN_CORRELATE_FFT_THRESHOLD
+#define PYTHRAN_CORRELATE_FFT_THRESHOLD 64
+#endif
+
 PYTHONIC_NS_BEGIN
 
 namespace numpy
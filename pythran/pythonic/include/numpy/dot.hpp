@@ -5,6 +5,7 @@
 #include "pythonic/include/numpy/sum.hpp"
 #include "pythonic/include/types/numpy_expr.hpp"
 #include "pythonic/include/types/traits.hpp"
+#include "pythonic/include/utils/gemm.hpp"
 
 template <class T>
 struct is_blas_type : pythonic::types::is_complex<T> {
@@ -143,8 +144,8 @@ namespace numpy
           types::pshape<long>>>::type
   dot(E const &e, F const &f);
 
-  // If one of the arg doesn't have a "blas compatible type", we use a slow
-  // matrix vector multiplication.
+  // If one of the arg doesn't have a "blas compatible type", we use the
+  // in-tree matrix vector multiplication.
   template <class E, class F>
   typename std::enable_if<
       (!is_blas_type<typename E::dtype>::value ||
@@ -155,8 +156,8 @@ namespace numpy
           types::pshape<long>>>::type
   dot(E const &e, F const &f);
 
-  // If one of the arg doesn't have a "blas compatible type", we use a slow
-  // matrix vector multiplication.
+  // If one of the arg doesn't have a "blas compatible type", we use the
+  // in-tree matrix vector multiplication.
   template <class E, class F>
   typename std::enable_if<
       (!is_blas_type<typename E::dtype>::value ||
@@ -184,9 +185,9 @@ namespace numpy
   typename std::enable_if<
       is_blas_type<E>::value && std::tuple_size<pS0>::value == 2 &&
           std::tuple_size<pS1>::value == 2 && std::tuple_size<pS2>::value == 2,
-      types::ndarray<E, pS2>>::type &
+      types::ndarray<E, pS2>>::type
   dot(types::ndarray<E, pS0> const &a, types::ndarray<E, pS1> const &b,
-      types::ndarray<E, pS2> &c);
+      types::ndarray<E, pS2> c);
 
   // texpr variants: MT, TM, TT
   template <class E, class pS0, class pS1>
@@ -228,8 +229,8 @@ namespace numpy
           types::array<long, 2>>>::type
   dot(E const &e, F const &f);
 
-  // If one of the arg doesn't have a "blas compatible type", we use a slow
-  // matrix multiplication.
+  // If one of the arg doesn't have a "blas compatible type", we use the
+  // in-tree matrix multiplication.
   template <class E, class F>
   typename std::enable_if<
       (!is_blas_type<typename E::dtype>::value ||
@@ -240,6 +241,14 @@ namespace numpy
           types::array<long, 2>>>::type
   dot(E const &e, F const &f);
 
+  template <class E, class F, class T, class pS>
+  typename std::enable_if<(!is_blas_type<typename E::dtype>::value ||
+                           !is_blas_type<typename F::dtype>::value) &&
+                              E::value == 2 && F::value == 2 &&
+                              std::tuple_size<pS>::value == 2,
+                          types::ndarray<T, pS>>::type
+  dot(E const &e, F const &f, types::ndarray<T, pS> c);
+
   DEFINE_FUNCTOR(pythonic::numpy, dot);
 }
 PYTHONIC_NS_END
@@ -0,0 +1,22 @@
+#ifndef PYTHONIC_INCLUDE_NUMPY_FROMBUFFER_HPP
+#define PYTHONIC_INCLUDE_NUMPY_FROMBUFFER_HPP
+
+#include "pythonic/include/utils/functor.hpp"
+#include "pythonic/include/numpy/float64.hpp"
+#include "pythonic/include/types/ndarray.hpp"
+#include "pythonic/include/types/str.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  template <class dtype = functor::float64>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  frombuffer(types::str const &buffer, dtype d = dtype(), long count = -1,
+             long offset = 0);
+
+  DEFINE_FUNCTOR(pythonic::numpy, frombuffer);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -8,9 +8,34 @@ PYTHONIC_NS_BEGIN
 
 namespace numpy
 {
+  namespace details
+  {
+    // number of dimensions of a key, sequences being one dimensional
+    template <class K, bool = types::is_array<K>::value>
+    struct lexsort_key_dims : std::integral_constant<size_t, 1> {
+    };
+
+    template <class K>
+    struct lexsort_key_dims<K, true>
+        : std::integral_constant<size_t, K::value> {
+    };
+
+    template <class pS>
+    using lexsort_dims = lexsort_key_dims<typename std::decay<decltype(
+        std::get<0>(std::declval<pS const &>()))>::type>;
+  }
+
+  template <class pS>
+  typename std::enable_if<details::lexsort_dims<pS>::value == 1,
+                          types::ndarray<long, types::pshape<long>>>::type
+  lexsort(pS const &keys, long axis = -1);
 
   template <class pS>
-  types::ndarray<long, types::pshape<long>> lexsort(pS const &keys);
+  typename std::enable_if<
+      (details::lexsort_dims<pS>::value > 1),
+      types::ndarray<long, types::array<long, details::lexsort_dims<
+                                                  pS>::value>>>::type
+  lexsort(pS const &keys, long axis = -1);
 
   DEFINE_FUNCTOR(pythonic::numpy, lexsort)
 }
@@ -3,20 +3,65 @@
 
 #include "pythonic/include/utils/functor.hpp"
 #include "pythonic/include/types/ndarray.hpp"
-#include "pythonic/include/numpy/asarray.hpp"
+#include "pythonic/include/numpy/isnan.hpp"
 #include <algorithm>
+#include <vector>
 
 PYTHONIC_NS_BEGIN
 
 namespace numpy
 {
-  template <class T, class pS>
-  decltype(std::declval<T>() + 1.) median(types::ndarray<T, pS> const &arr);
+  namespace details
+  {
+    template <class T>
+    using median_type = decltype(std::declval<T>() + 1.);
+
+    template <class E>
+    using median_axis_type = typename std::conditional<
+        E::value == 1, median_type<typename E::dtype>,
+        types::ndarray<median_type<typename E::dtype>,
+                       types::array<long, E::value - 1>>>::type;
+
+    /* Selection kernels shared by median, nanmedian, quantile and
+     * percentile. Each one is given a mutable buffer of n values and may
+     * reorder it at will.
+     */
+    struct median_kernel {
+      template <class T>
+      median_type<T> operator()(T *first, long n) const;
+    };
+
+    struct nanmedian_kernel {
+      template <class T>
+      median_type<T> operator()(T *first, long n) const;
+    };
+
+    struct quantile_kernel {
+      double q;
+      template <class T>
+      median_type<T> operator()(T *first, long n) const;
+    };
+
+    template <class E, class K>
+    median_type<typename E::dtype> select(E const &expr, K const &kernel);
+
+    template <class E, class K>
+    median_axis_type<E> select(E const &expr, long axis, K const &kernel);
+  }
+
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_type<typename E::dtype>>::type
+  median(E const &arr, types::none_type axis = types::none_type());
 
   template <class T, class pS>
-  decltype(std::declval<T>() + 1.) median(types::ndarray<T, pS> &&arr);
+  details::median_type<T> median(types::ndarray<T, pS> &&arr,
+                                 types::none_type axis = types::none_type());
 
-  NUMPY_EXPR_TO_NDARRAY0_DECL(median);
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_axis_type<E>>::type
+  median(E const &arr, long axis);
 
   DEFINE_FUNCTOR(pythonic::numpy, median);
 }
@@ -0,0 +1,46 @@
+#ifndef PYTHONIC_INCLUDE_NUMPY_MEMMAP_HPP
+#define PYTHONIC_INCLUDE_NUMPY_MEMMAP_HPP
+
+#include "pythonic/include/utils/functor.hpp"
+#include "pythonic/include/numpy/uint8.hpp"
+#include "pythonic/include/types/ndarray.hpp"
+#include "pythonic/include/types/str.hpp"
+#include "pythonic/include/types/NoneType.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  namespace details
+  {
+    /* Maps `count` elements of `filename` starting at byte `offset`, or all
+     * the remaining ones if count is negative, in which case it is updated.
+     * The resulting memory is unmapped along with the array.
+     */
+    template <class T>
+    utils::shared_ref<types::raw_array<T>> map_file(types::str const &filename,
+                                                    types::str const &mode,
+                                                    long offset, long &count);
+  }
+
+  template <class dtype = functor::uint8>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  memmap(types::str const &filename, dtype d = dtype(),
+         types::str const &mode = "r+", long offset = 0,
+         types::none_type shape = {});
+
+  template <class dtype>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  memmap(types::str const &filename, dtype d, types::str const &mode,
+         long offset, long shape);
+
+  template <class dtype, class pS>
+  types::ndarray<typename dtype::type, sutils::shape_t<pS>>
+  memmap(types::str const &filename, dtype d, types::str const &mode,
+         long offset, pS const &shape);
+
+  DEFINE_FUNCTOR(pythonic::numpy, memmap);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,34 @@
+#ifndef PYTHONIC_INCLUDE_NUMPY_NDARRAY_TOFILE_HPP
+#define PYTHONIC_INCLUDE_NUMPY_NDARRAY_TOFILE_HPP
+
+#include "pythonic/include/utils/functor.hpp"
+#include "pythonic/include/utils/numpy_conversion.hpp"
+#include "pythonic/include/types/ndarray.hpp"
+#include "pythonic/include/types/file.hpp"
+#include "pythonic/include/types/str.hpp"
+#include "pythonic/include/types/NoneType.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+
+  namespace ndarray
+  {
+    template <class T, class pS>
+    types::none_type tofile(types::ndarray<T, pS> const &expr, types::file f,
+                            types::str const &sep = {},
+                            types::str const &format = "%s");
+
+    template <class T, class pS>
+    types::none_type tofile(types::ndarray<T, pS> const &expr,
+                            types::str const &filename,
+                            types::str const &sep = {},
+                            types::str const &format = "%s");
+
+    NUMPY_EXPR_TO_NDARRAY0_DECL(tofile);
+    DEFINE_FUNCTOR(pythonic::numpy::ndarray, tofile);
+  }
+}
+PYTHONIC_NS_END
+#endif
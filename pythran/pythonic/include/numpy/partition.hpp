@@ -0,0 +1,40 @@
+#ifndef PYTHONIC_INCLUDE_NUMPY_PARTITION_HPP
+#define PYTHONIC_INCLUDE_NUMPY_PARTITION_HPP
+
+#include "pythonic/include/utils/functor.hpp"
+#include "pythonic/include/types/ndarray.hpp"
+#include "pythonic/include/types/str.hpp"
+
+#include <vector>
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  namespace details
+  {
+    /* Sorted && deduplicated positions selected by kth in lanes of n
+     * elements, negative positions counting from the end.
+     */
+    std::vector<long> partition_kth(long kth, long n);
+
+    template <class K>
+    std::vector<long> partition_kth(K const &kth, long n);
+
+    void partition_kind(types::str const &kind);
+  }
+
+  template <class E, class K>
+  types::ndarray<typename E::dtype, types::array<long, E::value>>
+  partition(E const &expr, K const &kth, long axis = -1);
+
+  template <class E, class K>
+  types::ndarray<typename E::dtype, types::array<long, E::value>>
+  partition(E const &expr, K const &kth, long axis, types::str const &kind);
+
+  NUMPY_EXPR_TO_NDARRAY0_DECL(partition);
+  DEFINE_FUNCTOR(pythonic::numpy, partition);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef PYTHONIC_INCLUDE_NUMPY_PERCENTILE_HPP
+#define PYTHONIC_INCLUDE_NUMPY_PERCENTILE_HPP
+
+#include "pythonic/include/utils/functor.hpp"
+#include "pythonic/include/types/ndarray.hpp"
+#include "pythonic/include/numpy/median.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_type<typename E::dtype>>::type
+  percentile(E const &arr, double q,
+             types::none_type axis = types::none_type());
+
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_axis_type<E>>::type
+  percentile(E const &arr, double q, long axis);
+
+  DEFINE_FUNCTOR(pythonic::numpy, percentile);
+}
+PYTHONIC_NS_END
+
+#endif
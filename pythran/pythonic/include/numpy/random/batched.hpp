@@ -0,0 +1,59 @@
+#ifndef PYTHONIC_INCLUDE_NUMPY_RANDOM_BATCHED_HPP
+#define PYTHONIC_INCLUDE_NUMPY_RANDOM_BATCHED_HPP
+
+#include "pythonic/include/numpy/random/generator.hpp"
+
+#ifdef USE_XSIMD
+#include <xsimd/xsimd.hpp>
+
+PYTHONIC_NS_BEGIN
+namespace numpy
+{
+  namespace random
+  {
+    namespace details
+    {
+
+      /* A few pcg streams stepped in lockstep, so that the compiler can
+       * vectorize the state update across them. Each lane is seeded from
+       * the engine it is built from, on its own stream.
+       */
+      struct pcg_lanes {
+        static constexpr size_t width = 8;
+        uint64_t state[width];
+        uint64_t inc[width];
+
+        explicit pcg_lanes(pcg &engine);
+
+        // Fill out[0:n], n being a multiple of width, with doubles uniformly
+        // distributed over [1, 2), built from 52 random mantissa bits.
+        void next(double *out, size_t n);
+      };
+
+      /* Kernels for thread_streams::fill_batched: uniform words are drawn
+       * in blocks from pcg_lanes, then transformed with xsimd.
+       */
+      struct uniform_kernel {
+        double low, high;
+        void operator()(pcg &engine, double *first, double *last) const;
+      };
+
+      // Box-Muller transform
+      struct normal_kernel {
+        double loc, scale;
+        void operator()(pcg &engine, double *first, double *last) const;
+      };
+
+      // Inversion of the cumulative distribution function
+      struct exponential_kernel {
+        double scale;
+        void operator()(pcg &engine, double *first, double *last) const;
+      };
+    }
+  }
+}
+PYTHONIC_NS_END
+
+#endif
+
+#endif
@@ -3,6 +3,16 @@
 
 #include <random>
 
+#ifdef _OPENMP
+#include <omp.h>
+
+// as a macro so that an enlightened user can modify this variable :-)
+#ifndef PYTHRAN_OPENMP_MIN_ITERATION_COUNT
+#define PYTHRAN_OPENMP_MIN_ITERATION_COUNT 1000
+#endif
+
+#endif
+
 PYTHONIC_NS_BEGIN
 namespace numpy
 {
@@ -36,10 +46,17 @@ namespace numpy
        *       http://www.pcg-random.org
        */
 
+      struct pcg_lanes;
+
       class pcg
       {
         uint64_t state;
-        static constexpr uint64_t inc = 0xda3e39cb94b95bdbULL;
+        // odd increment, which selects one of 2^63 distinct streams
+        uint64_t inc;
+        static constexpr uint64_t multiplier = 6364136223846793005ULL;
+        static constexpr uint64_t default_inc = 0xda3e39cb94b95bdbULL;
+
+        friend struct pcg_lanes;
 
       public:
         using result_type = uint32_t;
@@ -53,20 +70,29 @@ namespace numpy
         }
         friend bool operator==(pcg const &self, pcg const &other)
         {
-          return self.state == other.state;
+          return self.state == other.state && self.inc == other.inc;
         }
         friend bool operator!=(pcg const &self, pcg const &other)
         {
-          return self.state != other.state;
+          return !(self == other);
         }
 
-        pcg() : state(0)
+        pcg() : state(0), inc(default_inc)
         {
         }
-        explicit pcg(std::random_device &rd)
+        explicit pcg(std::random_device &rd) : inc(default_inc)
         {
           seed(rd());
         }
+        // Generator seeded with initstate on stream number stream, as
+        // pcg32_srandom_r does.
+        pcg(uint64_t initstate, uint64_t stream)
+            : state(0), inc((stream << 1u) | 1u)
+        {
+          (void)operator()();
+          state += initstate;
+          (void)operator()();
+        }
 
         void seed(uint64_t value = 0)
         {
@@ -77,23 +103,101 @@ namespace numpy
         result_type operator()()
         {
           uint64_t oldstate = state;
-          state = oldstate * 6364136223846793005ULL + inc;
+          state = oldstate * multiplier + inc;
           uint32_t xorshifted = uint32_t(((oldstate >> 18u) ^ oldstate) >> 27u);
           int rot = oldstate >> 59u;
           return (xorshifted >> rot) | (xorshifted << ((-rot) & 31));
         }
 
+        // Jump ahead by delta steps in O(log(delta)), following Brown,
+        // "Random Number Generation with Arbitrary Stride".
+        void advance(uint64_t delta)
+        {
+          uint64_t cur_mult = multiplier, cur_plus = inc;
+          uint64_t acc_mult = 1, acc_plus = 0;
+          while (delta) {
+            if (delta & 1) {
+              acc_mult *= cur_mult;
+              acc_plus = acc_plus * cur_mult + cur_plus;
+            }
+            cur_plus *= cur_mult + 1;
+            cur_mult *= cur_mult;
+            delta >>= 1;
+          }
+          state = acc_mult * state + acc_plus;
+        }
+
         void discard(std::size_t n)
         {
-          for (std::size_t i = 0; i < n; ++i)
-            operator()();
+          advance(n);
         }
+      };
+
+      /* Random engine shared by all numpy.random functions.
+       *
+       * Outside of OpenMP parallel regions, draws come from a single pcg
+       * stream. Within a parallel region, each thread draws from its own pcg
+       * stream, derived from the last seed and the thread number, so that
+       * threads neither race on nor serialize over a shared state.
+       */
+      class thread_streams
+      {
+        pcg master;
+        uint64_t thread_seed;
+        // bumped whenever the per-thread streams must be derived again
+        unsigned long epoch;
+
+        struct local_stream {
+          pcg engine;
+          unsigned long epoch;
+          // set while generate runs a chunk on this thread
+          bool bound;
+        };
+        static local_stream &local();
+        pcg &current();
+
+        // Call body(lo, hi, engine) on consecutive chunks of [first, last)
+        template <class I, class Body>
+        void split(I first, I last, Body const &body);
+
+      public:
+        using result_type = pcg::result_type;
+        static constexpr result_type min()
+        {
+          return pcg::min();
+        }
+        static constexpr result_type max()
+        {
+          return pcg::max();
+        }
+
+        explicit thread_streams(std::random_device &rd);
+
+        void seed(uint64_t value = 0);
+        result_type operator()();
+
+        /* Fill [first, last) with successive values of f(), splitting the
+         * range across OpenMP threads when it is large enough. Each chunk
+         * gets its own copy of f and its own stream seeded from the master
+         * one, so the result only depends on the seed and the number of
+         * threads.
+         */
+        template <class I, class F>
+        void generate(I first, I last, F const &f);
+
+        // Same as generate, drawing from a copy of distribution.
+        template <class I, class D>
+        void fill(I first, I last, D const &distribution);
 
-      private:
+        /* Same as generate, for kernels that fill a whole contiguous chunk
+         * at once through kernel(engine, lo, hi).
+         */
+        template <class T, class K>
+        void fill_batched(T *first, T *last, K const &kernel);
       };
 
       std::random_device rd;
-      pcg generator(rd);
+      thread_streams generator(rd);
     } // namespace details
   }   // namespace random
 }
@@ -0,0 +1,86 @@
+#ifndef PYTHONIC_INCLUDE_TYPES_BORROWED_DICT_HPP
+#define PYTHONIC_INCLUDE_TYPES_BORROWED_DICT_HPP
+
+#include "pythonic/include/types/dict.hpp"
+
+#ifdef ENABLE_PYTHON_MODULE
+
+#include <iterator>
+
+PYTHONIC_NS_BEGIN
+
+namespace types
+{
+
+  /* Read-only view of a Python dict, its keys and values are converted on
+   * access.
+   *
+   * Same purpose && restrictions as borrowed_list: only valid during the
+   * call, while holding the GIL.
+   */
+  template <class K, class V>
+  class borrowed_dict
+  {
+    PyObject *obj;
+
+  public:
+    typedef K key_type;
+    typedef V mapped_type;
+    typedef K value_type;
+
+    // iterates over the keys, as Python does
+    struct iterator
+        : std::iterator<std::forward_iterator_tag, K, long, K *, K> {
+      PyObject *obj;
+      Py_ssize_t pos;
+      PyObject *key;
+      iterator() = default;
+      iterator(PyObject *obj, Py_ssize_t pos);
+      K operator*() const;
+      iterator &operator++();
+      bool operator==(iterator const &other) const;
+      bool operator!=(iterator const &other) const;
+      bool operator<(iterator const &other) const;
+    };
+    typedef iterator const_iterator;
+
+    borrowed_dict(PyObject *obj);
+
+    iterator begin() const;
+    iterator end() const;
+
+    long size() const;
+    explicit operator bool() const;
+
+    V operator[](K const &key) const;
+    V fast(K const &key) const;
+    bool contains(K const &key) const;
+  };
+}
+PYTHONIC_NS_END
+
+namespace std
+{
+  template <size_t I, class K, class V>
+  V get(pythonic::types::borrowed_dict<K, V> const &d);
+
+  template <size_t I, class K, class V>
+  struct tuple_element<I, pythonic::types::borrowed_dict<K, V>> {
+    using type = V;
+  };
+}
+
+PYTHONIC_NS_BEGIN
+
+template <class K, class V>
+struct from_python<types::borrowed_dict<K, V>> {
+
+  static bool is_convertible(PyObject *obj);
+
+  static types::borrowed_dict<K, V> convert(PyObject *obj);
+};
+PYTHONIC_NS_END
+
+#endif
+
+#endif
@@ -0,0 +1,89 @@
+#ifndef PYTHONIC_INCLUDE_TYPES_BORROWED_LIST_HPP
+#define PYTHONIC_INCLUDE_TYPES_BORROWED_LIST_HPP
+
+#include "pythonic/include/types/list.hpp"
+
+#ifdef ENABLE_PYTHON_MODULE
+
+#include <iterator>
+
+PYTHONIC_NS_BEGIN
+
+namespace types
+{
+
+  /* Read-only view of a Python list, its elements are converted on access.
+   *
+   * Exported functions get one instead of a list when they only read the
+   * argument, which saves the conversion of the elements they never touch.
+   * The view does ! own the Python object, and uses the Python C API, so it
+   * must ! outlive the call nor be used without holding the GIL.
+   */
+  template <class T>
+  class borrowed_list
+  {
+    PyObject *obj;
+
+  public:
+    typedef T value_type;
+    typedef T reference;
+    typedef T const_reference;
+    typedef long size_type;
+    typedef long difference_type;
+
+    struct iterator
+        : std::iterator<std::random_access_iterator_tag, T, long, T *, T> {
+      PyObject *const *curr;
+      iterator() = default;
+      iterator(PyObject *const *curr);
+      T operator*() const;
+      iterator &operator++();
+      iterator &operator--();
+      iterator &operator+=(long n);
+      iterator operator+(long n) const;
+      long operator-(iterator const &other) const;
+      bool operator==(iterator const &other) const;
+      bool operator!=(iterator const &other) const;
+      bool operator<(iterator const &other) const;
+    };
+    typedef iterator const_iterator;
+
+    borrowed_list(PyObject *obj);
+
+    iterator begin() const;
+    iterator end() const;
+
+    long size() const;
+    explicit operator bool() const;
+
+    T operator[](long i) const;
+    T fast(long i) const;
+  };
+}
+PYTHONIC_NS_END
+
+namespace std
+{
+  template <size_t I, class T>
+  T get(pythonic::types::borrowed_list<T> const &t);
+
+  template <size_t I, class T>
+  struct tuple_element<I, pythonic::types::borrowed_list<T>> {
+    typedef T type;
+  };
+}
+
+PYTHONIC_NS_BEGIN
+
+template <class T>
+struct from_python<types::borrowed_list<T>> {
+
+  static bool is_convertible(PyObject *obj);
+
+  static types::borrowed_list<T> convert(PyObject *obj);
+};
+PYTHONIC_NS_END
+
+#endif
+
+#endif
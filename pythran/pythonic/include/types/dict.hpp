@@ -6,6 +6,7 @@
 #include "pythonic/include/types/empty_iterator.hpp"
 
 #include "pythonic/include/utils/shared_ref.hpp"
+#include "pythonic/include/utils/flat_hash_map.hpp"
 #include "pythonic/include/utils/iterator.hpp"
 #include "pythonic/include/utils/reserve.hpp"
 
@@ -16,7 +17,6 @@
 #include <limits>
 #include <algorithm>
 #include <iterator>
-#include <unordered_map>
 
 PYTHONIC_NS_BEGIN
 
@@ -108,7 +108,7 @@ namespace types
         typename std::remove_cv<typename std::remove_reference<K>::type>::type;
     using _value_type =
         typename std::remove_cv<typename std::remove_reference<V>::type>::type;
-    using container_type = std::unordered_map<_key_type, _value_type>;
+    using container_type = utils::flat_hash_map<_key_type, _value_type>;
 
     utils::shared_ref<container_type> data;
     template <class Kp, class Vp>
@@ -15,6 +15,18 @@
 #include <cstdio>
 #include <unistd.h>
 
+// as a macro so that an enlightened user can modify this variable :-)
+// size of the blocks read at once from regular files
+#ifndef PYTHRAN_FILE_BUFFER_SIZE
+#define PYTHRAN_FILE_BUFFER_SIZE (1L << 20)
+#endif
+
+// as a macro so that an enlightened user can modify this variable :-)
+// minimal size of a whole file read() that maps the file instead of reading it
+#ifndef PYTHRAN_FILE_MMAP_THRESHOLD
+#define PYTHRAN_FILE_MMAP_THRESHOLD (1L << 20)
+#endif
+
 PYTHONIC_NS_BEGIN
 
 namespace types
@@ -27,6 +39,7 @@ namespace types
   private:
     file &f;
     types::str curr;
+    // number of lines read so far, -1 once the end of file is reached
     long position;
 
   public:
@@ -44,12 +57,29 @@ namespace types
     types::str const &operator*() const;
   };
 
+  /* Regular files are read by blocks of PYTHRAN_FILE_BUFFER_SIZE characters
+   * into `buffer`, where [first, last) are the characters read from `f` but
+   * ! consumed yet. Lines are handed out as views on that buffer, which is
+   * reused once no line refers to it anymore.
+   */
   struct _file {
     FILE *f;
+    bool buffered;
+    utils::shared_ref<std::string> buffer;
+    size_t first, last;
+
     _file();
     _file(types::str const &filename, types::str const &strmode = "r");
     FILE *operator*() const;
     ~_file();
+
+    size_t pending() const;
+    // reads more characters after the pending ones, false at end of file
+    bool fill();
+    // gives the pending characters back to `f`, before any direct access
+    void unread();
+    // the next n pending characters
+    types::str consume(size_t n);
   };
 
   class file
@@ -103,6 +133,9 @@ namespace types
 
     types::list<types::str> readlines(long sizehint = -1);
 
+    // reads at most size characters into out, returns the number read
+    long readinto(char *out, long size);
+
     void seek(long offset, long whence = SEEK_SET);
 
     long tell() const;
@@ -110,6 +143,7 @@ namespace types
     void truncate(long size = -1);
 
     void write(types::str const &str);
+    void write(char const *in, long size);
 
     template <class T>
     void writelines(T const &seq);
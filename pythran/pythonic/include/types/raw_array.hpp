@@ -25,13 +25,22 @@ namespace types
     raw_array();
     raw_array(size_t n);
     raw_array(T *d, ownership o);
+    // external memory within the file mapping [mapping, mapping + size),
+    // unmapped along with the array, && exported to numpy as read-only
+    // unless `writeable`
+    raw_array(T *d, void *mapping, size_t size, bool writeable = true);
     raw_array(raw_array<T> &&d);
     void forget();
+    bool is_mapped() const;
+    bool is_writeable() const;
 
     ~raw_array();
 
   private:
-    bool external;
+    bool external, writeable;
+    void *mapping;
+    // size of the mapping, or of the memory from utils::allocate, if any
+    size_t nbytes;
   };
 }
 PYTHONIC_NS_END
@@ -22,10 +22,12 @@ namespace types
 
   class str;
   struct const_sliced_str_iterator;
+  struct _file;
 
   template <class S = slice>
   class sliced_str
   {
+    friend class str;
 
     using container_type = std::string;
     utils::shared_ref<container_type> data;
@@ -95,12 +97,63 @@ namespace types
 
     template <class S>
     friend class sliced_str;
+    friend struct _file;
+    friend struct std::hash<str>;
 
     using container_type = std::string;
-    utils::shared_ref<container_type> data;
 
   public:
     static const size_t npos = -1 /*std::string::npos*/;
+    static const size_t inline_size = 15;
+    static const size_t view_ratio = 4;
+
+  private:
+    /* Strings of at most inline_size characters, among which all single
+     * characters, are stored in `small` without any allocation. Longer ones
+     * live in `data`, shared among copies, and get copied before being
+     * modified. Operations that change the size of a string move it to the
+     * storage that fits, so that const methods never modify the string,
+     * which may be read by several threads at once.
+     *
+     * A shared string may be a view on part of its buffer, namely
+     * (*data)[span.offset:span.offset + span.length], as built by substr,
+     * strip, split or slicing. Views are copied out of their parent buffer
+     * when modified, when copied, that is when stored in a variable || a
+     * container, && at creation when they span less than 1 / view_ratio of
+     * the buffer, so that a small piece of a large string does ! keep it
+     * alive.
+     *
+     * `small` && `span` share their storage, the former being used when
+     * `data` is null, so that a str takes three words, as a std::string.
+     */
+    struct inline_chars {
+      char chars[inline_size];
+      unsigned char size;
+    };
+    struct buffer_span {
+      size_t offset;
+      // npos when the string spans its whole buffer
+      size_t length;
+    };
+    utils::shared_ref<container_type> data{utils::no_memory()};
+    union {
+      inline_chars small;
+      buffer_span span;
+    };
+
+    str(utils::shared_ref<container_type> const &buffer, size_t pos,
+        size_t len);
+    bool is_view() const;
+    container_type &own();
+    void settle();
+    utils::shared_ref<container_type> shared() const;
+    void assign(char const *s, size_t n);
+    void assign(container_type &&s);
+    void take(str &other);
+    static int compare(char const *self, size_t n, char const *other,
+                       size_t m);
+
+  public:
     static constexpr bool is_vectorizable = false;
 
     using value_type = str; // in Python, a string contains... strings
@@ -109,6 +162,8 @@ namespace types
     using const_reverse_iterator = std::reverse_iterator<string_iterator>;
 
     str();
+    str(str const &other);
+    str(str &&other) noexcept;
     str(std::string const &s);
     str(std::string &&s);
     explicit str(char c);
@@ -128,28 +183,26 @@ namespace types
     explicit operator float() const;
     explicit operator double() const;
 
+    str &operator=(str const &other);
+    str &operator=(str &&other) noexcept;
     template <class S>
     str &operator=(sliced_str<S> const &other);
 
     types::str &operator+=(types::str const &s);
 
-    container_type const &get_data() const;
+    // a copy of the characters of the string
+    container_type get_data() const;
 
     long size() const;
     iterator begin() const;
     reverse_iterator rbegin() const;
     iterator end() const;
     reverse_iterator rend() const;
-    auto c_str() const -> decltype(data->c_str());
-    std::string &chars()
-    {
-      return *data;
-    }
-    std::string const &chars() const
-    {
-      return *data;
-    }
-    auto resize(long n) -> decltype(data->resize(n));
+    // the characters of the string, ! null-terminated
+    char const *raw() const;
+    // the characters of the string, to be modified in place
+    char *chars();
+    void resize(long n);
     long find(str const &s, size_t pos = 0) const;
     bool contains(str const &v) const;
     long find_first_of(str const &s, size_t pos = 0) const;
@@ -185,16 +238,15 @@ namespace types
     explicit operator bool() const;
     long count(types::str const &sub) const;
 
-    intptr_t id() const
-    {
-      return reinterpret_cast<intptr_t>(&(*data));
-    }
+    // derived from the characters, as `is` compares strings by value, so
+    // that copies share it
+    intptr_t id() const;
   };
 
   struct string_iterator : std::iterator<std::random_access_iterator_tag, str,
                                          std::ptrdiff_t, str *, str> {
-    std::string::const_iterator curr;
-    string_iterator(std::string::const_iterator iter) : curr(iter)
+    char const *curr;
+    string_iterator(char const *iter) : curr(iter)
     {
     }
     str operator*() const
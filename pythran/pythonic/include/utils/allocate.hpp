@@ -0,0 +1,49 @@
+#ifndef PYTHONIC_INCLUDE_UTILS_ALLOCATE_HPP
+#define PYTHONIC_INCLUDE_UTILS_ALLOCATE_HPP
+
+#include <cstddef>
+
+// as a macro so that an enlightened user can modify this variable :-)
+// alignment of array buffers, a cache line that also suits any SIMD register
+#ifndef PYTHRAN_ALLOCATOR_ALIGNMENT
+#define PYTHRAN_ALLOCATOR_ALIGNMENT 64
+#endif
+
+// as a macro so that an enlightened user can modify this variable :-)
+// number of bytes of released buffers each thread keeps for reuse (so n
+// threads may keep n times that amount), 0 turns pooling off
+#ifndef PYTHRAN_ALLOCATOR_POOL_SIZE
+#define PYTHRAN_ALLOCATOR_POOL_SIZE (64L << 20)
+#endif
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  /* Memory of the arrays built by pythran.
+   *
+   * Buffers are aligned on PYTHRAN_ALLOCATOR_ALIGNMENT bytes and rounded up
+   * to a size class, with four classes per power of two. Released buffers
+   * are kept in a per-thread pool, one list per size class, so that the
+   * temporaries of a loop body get recycled from one iteration to the next.
+   *
+   * Every buffer remains a separate system allocation that can be released
+   * through free(), which is what numpy does with the arrays we give it.
+   */
+  inline void *allocate(size_t bytes);
+  // `bytes` must be the size the buffer was allocated with
+  inline void deallocate(void *buffer, size_t bytes);
+
+  /* With PYTHRAN_ALLOCATOR_STATS defined, allocations are counted and a
+   * summary is printed on stderr at exit.
+   */
+  struct allocator_stats {
+    long allocations; // number of buffers requested
+    long bytes;       // total size of these buffers
+    long pool_hits;   // number of buffers recycled from the pool
+  };
+  inline allocator_stats get_allocator_stats();
+}
+PYTHONIC_NS_END
+
+#endif
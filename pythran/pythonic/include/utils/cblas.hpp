@@ -0,0 +1,63 @@
+#ifndef PYTHONIC_INCLUDE_UTILS_CBLAS_HPP
+#define PYTHONIC_INCLUDE_UTILS_CBLAS_HPP
+
+#include "pythonic/include/utils/gemm.hpp"
+
+#include <complex>
+
+/* In-tree implementation of the subset of the CBLAS interface used by
+ * numpy.dot, on top of the kernels of utils/gemm.hpp. It is used in place
+ * of <cblas.h> when PYTHRAN_BLAS_NONE is defined, that is with ``blas=none``
+ * in the pythran configuration, so that no BLAS library has to be linked.
+ */
+
+PYTHONIC_NS_BEGIN
+
+enum CBLAS_ORDER { CblasRowMajor = 101, CblasColMajor = 102 };
+enum CBLAS_TRANSPOSE {
+  CblasNoTrans = 111,
+  CblasTrans = 112,
+  CblasConjTrans = 113
+};
+
+float cblas_sdot(int n, float const *x, int incx, float const *y, int incy);
+double cblas_ddot(int n, double const *x, int incx, double const *y,
+                  int incy);
+void cblas_cdotu_sub(int n, void const *x, int incx, void const *y, int incy,
+                     void *dotu);
+void cblas_zdotu_sub(int n, void const *x, int incx, void const *y, int incy,
+                     void *dotu);
+
+void cblas_sgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 float alpha, float const *a, int lda, float const *x,
+                 int incx, float beta, float *y, int incy);
+void cblas_dgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 double alpha, double const *a, int lda, double const *x,
+                 int incx, double beta, double *y, int incy);
+void cblas_cgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 void const *alpha, void const *a, int lda, void const *x,
+                 int incx, void const *beta, void *y, int incy);
+void cblas_zgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 void const *alpha, void const *a, int lda, void const *x,
+                 int incx, void const *beta, void *y, int incy);
+
+void cblas_sgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k, float alpha,
+                 float const *a, int lda, float const *b, int ldb, float beta,
+                 float *c, int ldc);
+void cblas_dgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k, double alpha,
+                 double const *a, int lda, double const *b, int ldb,
+                 double beta, double *c, int ldc);
+void cblas_cgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k,
+                 void const *alpha, void const *a, int lda, void const *b,
+                 int ldb, void const *beta, void *c, int ldc);
+void cblas_zgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k,
+                 void const *alpha, void const *a, int lda, void const *b,
+                 int ldb, void const *beta, void *c, int ldc);
+
+PYTHONIC_NS_END
+
+#endif
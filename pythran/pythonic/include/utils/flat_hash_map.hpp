@@ -0,0 +1,171 @@
+#ifndef PYTHONIC_INCLUDE_UTILS_FLAT_HASH_MAP_HPP
+#define PYTHONIC_INCLUDE_UTILS_FLAT_HASH_MAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+
+  /* Insertion-ordered, open-addressing hash map, the backing store of
+   * types::dict.
+   *
+   * Following CPython's compact dict, entries are stored densely, in
+   * insertion order, and a separate index table maps hashes to positions in
+   * that sequence. The index table is probed linearly from a position given
+   * by Fibonacci hashing, and each of its slots holds 32 bits of the hash
+   * next to the position of the entry, so that a lookup only touches the
+   * entry it returns, most of the time.
+   *
+   * Entries live in chunks of geometrically increasing size that are never
+   * reallocated: like with std::unordered_map, a reference obtained through
+   * operator[] survives later insertions. Erased entries are left as holes,
+   * swept once they outnumber live entries.
+   */
+  template <class K, class V, class Hash = std::hash<K>,
+            class KeyEqual = std::equal_to<K>>
+  class flat_hash_map
+  {
+    struct entry {
+      std::pair<K, V> kv;
+      size_t hash;
+      bool live;
+    };
+
+    template <class Map, class Value>
+    struct basic_iterator {
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::pair<K, V>;
+      using difference_type = std::ptrdiff_t;
+      using pointer = Value *;
+      using reference = Value &;
+
+      Map *map;
+      size_t index;
+      // the entry at index, so that dereferencing the result of a lookup
+      // does not locate it again
+      Value *value;
+
+      basic_iterator();
+      basic_iterator(Map *map, size_t index);
+      basic_iterator(Map *map, size_t index, Value *value);
+      template <class OtherMap, class OtherValue>
+      basic_iterator(basic_iterator<OtherMap, OtherValue> const &other);
+
+      Value &operator*() const;
+      Value *operator->() const;
+      basic_iterator &operator++();
+      basic_iterator operator++(int);
+      bool operator==(basic_iterator const &other) const;
+      bool operator!=(basic_iterator const &other) const;
+    };
+
+  public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using reference = value_type &;
+    using const_reference = value_type const &;
+    using pointer = value_type *;
+    using const_pointer = value_type const *;
+    using size_type = size_t;
+    using difference_type = std::ptrdiff_t;
+    using allocator_type = std::allocator<value_type>;
+    using iterator = basic_iterator<flat_hash_map, value_type>;
+    using const_iterator =
+        basic_iterator<flat_hash_map const, value_type const>;
+
+    flat_hash_map();
+    explicit flat_hash_map(size_type capacity);
+    template <class I>
+    flat_hash_map(I first, I last);
+    // chunks are copied with their full capacity reserved, so that the copy
+    // never reallocates them either
+    flat_hash_map(flat_hash_map const &other);
+    // the moved-from map is left empty, && usable
+    flat_hash_map(flat_hash_map &&other);
+    flat_hash_map &operator=(flat_hash_map const &other);
+    flat_hash_map &operator=(flat_hash_map &&other);
+
+    iterator begin();
+    const_iterator begin() const;
+    iterator end();
+    const_iterator end() const;
+
+    bool empty() const;
+    size_type size() const;
+
+    V &operator[](K const &key);
+    iterator find(K const &key);
+    const_iterator find(K const &key) const;
+    template <class Kp, class Vp>
+    std::pair<iterator, bool> insert_or_assign(Kp &&key, Vp &&value);
+
+    iterator erase(const_iterator pos);
+    // Remove and return the most recently inserted entry, as
+    // dict.popitem does.
+    value_type pop_back();
+    void clear();
+    void reserve(size_type count);
+
+  private:
+    static constexpr size_t min_capacity = 16;
+    static constexpr size_t first_chunk_size = 16;
+    static constexpr uint32_t empty_slot = ~uint32_t(0);
+    static constexpr uint32_t deleted_slot = ~uint32_t(0) - 1;
+
+    // index of an entry, || one of the markers above, along with the low
+    // bits of its hash
+    struct slot {
+      uint32_t hash;
+      uint32_t index;
+    };
+
+    std::vector<slot> slots_;
+    // chunk i holds up to first_chunk_size << i entries, in insertion
+    // order, possibly with holes
+    std::vector<std::vector<entry>> chunks_;
+    // number of entries, holes included
+    size_type count_;
+    size_type size_;
+    size_type holes_;
+    // number of slots that can still turn from empty to full before
+    // reaching the maximum load factor
+    size_type growth_left_;
+    // 64 minus the log2 of the number of slots
+    int shift_;
+
+    static uint32_t tag(size_t hash);
+    size_t home(size_t hash) const;
+    static size_type max_load(size_type capacity);
+
+    static size_t chunk_size(size_t chunk);
+    entry &entry_at(size_t index);
+    entry const &entry_at(size_t index) const;
+    void push_entry(entry &&e);
+    void pop_entry();
+    size_t next_live(size_t index) const;
+
+    size_t hash_of(K const &key) const;
+    size_type capacity() const;
+    // entry holding key, stored at index, || nullptr
+    entry *find_entry(K const &key, size_t hash, size_t &index) const;
+    size_t find_insert_slot(size_t hash) const;
+    void set_slot(size_t pos, size_t hash, uint32_t index);
+    void erase_index(size_t index);
+    template <class Kp, class Vp>
+    iterator emplace_new(size_t hash, Kp &&key, Vp &&value);
+    void rehash(size_type capacity);
+    void compact();
+    void drop_trailing_holes();
+  };
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef PYTHONIC_INCLUDE_UTILS_GEMM_HPP
+#define PYTHONIC_INCLUDE_UTILS_GEMM_HPP
+
+#include <cstddef>
+
+#ifdef USE_XSIMD
+#include <xsimd/xsimd.hpp>
+#endif
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+
+  /* Read-only strided view on a matrix: element (i, j) lives at
+   * data[i * row_stride + j * col_stride]. This covers C and Fortran ordered
+   * buffers as well as sliced views, without copying them.
+   */
+  template <class T>
+  struct matrix_view {
+    T const *data;
+    long row_stride;
+    long col_stride;
+
+    T const &operator()(long i, long j) const;
+    matrix_view transpose() const;
+  };
+
+  template <class T>
+  struct vector_view {
+    T const *data;
+    long stride;
+
+    T const &operator[](long i) const;
+  };
+
+  /* out[m, n] = a[m, k] . b[k, n], out being a row major buffer.
+   *
+   * Operands are copied by cache-sized blocks into packed buffers of the
+   * output type, which takes care of strides and dtype conversions at
+   * once, then multiplied by a register-blocked micro-kernel, written with
+   * xsimd for floating point types.
+   */
+  template <class T, class TA, class TB>
+  void gemm(long m, long n, long k, matrix_view<TA> a, matrix_view<TB> b,
+            T *out);
+
+  // out[m] = a[m, n] . x[n]
+  template <class T, class TA, class TX>
+  void gemv(long m, long n, matrix_view<TA> a, vector_view<TX> x, T *out);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PYTHONIC_INCLUDE_UTILS_PARALLEL_REDUCE_HPP
+#define PYTHONIC_INCLUDE_UTILS_PARALLEL_REDUCE_HPP
+
+#include "pythonic/include/types/slice.hpp"
+
+#include <type_traits>
+#include <utility>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// as a macro so that an enlightened user can modify this variable :-)
+// number of elements reduced by a single task, reductions over fewer than
+// two blocks remain sequential
+#ifndef PYTHRAN_OPENMP_REDUCTION_BLOCK
+#define PYTHRAN_OPENMP_REDUCTION_BLOCK 32768
+#endif
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  /* Whether an expression can be split in blocks along its first axis, that
+   * is sliced into expressions holding the same elements
+   */
+  template <class E, class Enable = void>
+  struct is_splittable : std::false_type {
+  };
+
+  template <class E>
+  struct is_splittable<
+      E, typename std::enable_if<std::is_same<
+             typename E::dtype,
+             typename std::decay<decltype(std::declval<E const &>()[
+                 types::contiguous_slice(0, 0)])>::type::dtype>::value>::type>
+      : std::true_type {
+  };
+
+  /* Reduce the range [0, n) by blocks of `block` indices: `chunk(lo, hi)`
+   * computes the partial result of a block, and the partial results are
+   * merged along a balanced binary tree, in block order, by
+   * `combine(left, right)` which updates `left` in place.
+   *
+   * Blocks only depend on `n` and `block`, so the result does ! depend on
+   * the number of threads the blocks are spread on.
+   */
+  template <class T, class Chunk, class Combine>
+  T parallel_reduce(long n, long block, Chunk chunk, Combine combine);
+}
+PYTHONIC_NS_END
+
+#endif
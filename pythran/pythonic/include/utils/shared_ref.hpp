@@ -83,6 +83,12 @@ namespace utils
 
     T *operator->() const noexcept;
 
+    // Whether some memory is managed, i.e. ! built from no_memory
+    explicit operator bool() const noexcept;
+
+    // Whether this is the only reference to the managed memory
+    bool unique() const noexcept;
+
     bool operator!=(shared_ref<T> const &other) const noexcept;
     bool operator==(shared_ref<T> const &other) const noexcept;
 
@@ -0,0 +1,187 @@
+#ifndef PYTHONIC_INCLUDE_UTILS_SORT_HPP
+#define PYTHONIC_INCLUDE_UTILS_SORT_HPP
+
+#include <complex>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+// as a macro so that an enlightened user can modify this variable :-)
+// rows of at most this many elements are insertion sorted, || sorted by tiles
+// through a vectorized sorting network
+#ifndef PYTHRAN_SHORT_SORT_SIZE
+#define PYTHRAN_SHORT_SORT_SIZE 16
+#endif
+
+// as a macro so that an enlightened user can modify this variable :-)
+// number of lanes sorted at once along an axis other than the last one
+#ifndef PYTHRAN_SORT_TILE
+#define PYTHRAN_SORT_TILE 64
+#endif
+
+// as a macro so that an enlightened user can modify this variable :-)
+// rows of at least this many elements are radix sorted when their dtype
+// allows it, whatever the sorting kind
+#ifndef PYTHRAN_RADIX_SORT_THRESHOLD
+#define PYTHRAN_RADIX_SORT_THRESHOLD 256
+#endif
+
+// as a macro so that an enlightened user can modify this variable :-)
+// selecting one of the this many smallest || largest elements of a long row
+// goes through a heap instead of introselect
+#ifndef PYTHRAN_TOP_K_SIZE
+#define PYTHRAN_TOP_K_SIZE 1024
+#endif
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  /* Ascending order of numpy: NaN compare greater than any other value,
+   * complex numbers compare by real part first.
+   */
+  template <class T>
+  struct sort_less {
+    bool operator()(T const &i, T const &j) const;
+  };
+
+  template <class T>
+  struct sort_less<std::complex<T>> {
+    bool operator()(std::complex<T> const &i,
+                    std::complex<T> const &j) const;
+  };
+
+  /* Orders (value, index) pairs by value, then by index, so that sorting
+   * them gives the stable argsort whatever the algorithm.
+   */
+  template <class T>
+  struct argsort_less {
+    bool operator()(std::pair<T, long> const &i,
+                    std::pair<T, long> const &j) const;
+  };
+
+  /* Order preserving map from T to an unsigned integer: key(i) < key(j) iff
+   * sort_less<T>{}(i, j). All NaN share the largest key, && both zeros
+   * share the same key, so that radix sorts stay stable.
+   */
+  template <class T, class Enable = void>
+  struct radix_key {
+    static constexpr bool value = false;
+  };
+
+  template <>
+  struct radix_key<bool> {
+    static constexpr bool value = true;
+    using type = uint8_t;
+    static type get(bool x);
+  };
+
+  template <class T>
+  struct radix_key<T, typename std::enable_if<
+                          std::is_integral<T>::value &&
+                          !std::is_same<T, bool>::value>::type> {
+    static constexpr bool value = true;
+    using type = typename std::make_unsigned<T>::type;
+    static type get(T x);
+  };
+
+  template <>
+  struct radix_key<float> {
+    static constexpr bool value = true;
+    using type = uint32_t;
+    static type get(float x);
+  };
+
+  template <>
+  struct radix_key<double> {
+    static constexpr bool value = true;
+    using type = uint64_t;
+    static type get(double x);
+  };
+
+  /* Stable LSD radix sort of [first, last), one byte of the key per pass.
+   * Passes where all the elements share the same byte are skipped.
+   */
+  template <class T>
+  void radix_sort(T *first, T *last);
+
+  /* Store in indices[0:n] the stable argsort of values[0:n].
+   *
+   * (key, index) pairs are sorted together, so that the values are read once.
+   */
+  template <class T>
+  void radix_argsort(T const *values, long *indices, long n);
+
+  /* Call compare_exchange(i, j) along Batcher's merge exchange network
+   * sorting n elements (Knuth, TAOCP 5.2.2, algorithm M). The network does
+   * ! depend on the values, so that it can sort several rows at once.
+   */
+  template <class F>
+  void merge_exchange(long n, F compare_exchange);
+
+  /* Sort `width` interleaved rows of n elements in place, element k of row l
+   * being tile[k * ld + l]. Rows are processed by vector batches when xsimd
+   * supports T.
+   */
+  template <class T>
+  void network_sort(T *tile, long n, long width, long ld);
+
+  /* Stable insertion sort of [first, last), for short rows */
+  template <class T>
+  void insertion_sort(T *first, T *last);
+
+  /* Store in indices[0:n] the stable argsort of values[0:n], through an
+   * insertion sort of (value, index) pairs. n must ! exceed
+   * PYTHRAN_SHORT_SORT_SIZE.
+   */
+  template <class T>
+  void insertion_argsort(T const *values, long *indices, long n);
+
+  /* Rearrange [first, last) as std::nth_element does, with respect to less.
+   * When nth is among the PYTHRAN_TOP_K_SIZE first || last elements of a
+   * long enough range, these elements are kept in a heap while the others
+   * are scanned once. Introselect is used otherwise, || when too many
+   * elements reach the heap.
+   */
+  template <class T, class Less>
+  void nth_element(T *first, T *nth, T *last, Less less);
+
+  /* Sorting engine along any axis of a C-contiguous array, seen as an array
+   * of shape (outer, n, inner) where a lane gathers the n elements of given
+   * outer && inner indices.
+   *
+   * Rows, that is lanes of an array where inner is 1, are processed in
+   * place. Other lanes are transposed by tiles of PYTHRAN_SORT_TILE lanes
+   * into a scratch buffer owned by each thread, so that the array is only
+   * read && written along its last axis. Lanes are spread among threads
+   * under OpenMP.
+   */
+
+  /* Whether `tasks` independent tasks over an array of `size` elements are
+   * worth spreading among threads.
+   */
+  bool parallel_lanes(long size, long tasks);
+
+  // lanes[l * n + k] = tile[k * ld + l], for k < n && l < width
+  template <class T>
+  void gather_tile(T *lanes, T const *tile, long n, long ld, long width);
+
+  // tile[k * ld + l] = lanes[l * n + k], for k < n && l < width
+  template <class T>
+  void scatter_tile(T *tile, T const *lanes, long n, long ld, long width);
+
+  /* Call kernel(lane, n) on each lane of data, which it reorders in place */
+  template <class T, class Kernel>
+  void sort_lanes(T *data, long outer, long n, long inner,
+                  Kernel const &kernel);
+
+  /* Call kernel(lane, result, n) on each lane of in, which stores in
+   * result[0:n] the matching lane of out.
+   */
+  template <class T, class U, class Kernel>
+  void map_lanes(T const *in, U *out, long outer, long n, long inner,
+                 Kernel const &kernel);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -6,8 +6,11 @@
 #include "pythonic/utils/functor.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
+#include "pythonic/utils/parallel_reduce.hpp"
 #include "pythonic/numpy/multiply.hpp"
 
+#include <atomic>
+
 PYTHONIC_NS_BEGIN
 
 namespace numpy
@@ -29,11 +32,49 @@ namespace numpy
     return true;
   }
 
+#ifdef _OPENMP
+  template <class E>
+  typename std::enable_if<!utils::is_splittable<E>::value, bool>::type
+  _all_par(E const &expr)
+  {
+    return _all(expr.begin(), expr.end(), utils::int_<E::value>());
+  }
+
+  template <class E>
+  typename std::enable_if<utils::is_splittable<E>::value, bool>::type
+  _all_par(E const &expr)
+  {
+    long n = expr.flat_size();
+    if (n < 2 * PYTHRAN_OPENMP_REDUCTION_BLOCK || !utils::no_broadcast(expr))
+      return _all(expr.begin(), expr.end(), utils::int_<E::value>());
+    long size = std::get<0>(expr.shape());
+    long row_size = n / size;
+    std::atomic<bool> failed(false);
+    return utils::parallel_reduce<bool>(
+        size, std::max(1L, PYTHRAN_OPENMP_REDUCTION_BLOCK / row_size),
+        [&expr, &failed](long lo, long hi) {
+          // another block already holds a false value
+          if (failed.load(std::memory_order_relaxed))
+            return false;
+          auto chunk = expr[types::contiguous_slice(lo, hi)];
+          bool res = _all(chunk.begin(), chunk.end(), utils::int_<E::value>());
+          if (!res)
+            failed.store(true, std::memory_order_relaxed);
+          return res;
+        },
+        [](bool &self, bool other) { self = self && other; });
+  }
+#endif
+
   template <class E>
   typename std::enable_if<types::is_numexpr_arg<E>::value, bool>::type
   all(E const &expr, types::none_type)
   {
+#ifdef _OPENMP
+    return _all_par(expr);
+#else
     return _all(expr.begin(), expr.end(), utils::int_<E::value>());
+#endif
   }
 
   template <class E>
@@ -6,8 +6,11 @@
 #include "pythonic/utils/functor.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
+#include "pythonic/utils/parallel_reduce.hpp"
 #include "pythonic/numpy/add.hpp"
 
+#include <atomic>
+
 PYTHONIC_NS_BEGIN
 
 namespace numpy
@@ -29,11 +32,49 @@ namespace numpy
     return false;
   }
 
+#ifdef _OPENMP
+  template <class E>
+  typename std::enable_if<!utils::is_splittable<E>::value, bool>::type
+  _any_par(E const &expr)
+  {
+    return _any(expr, utils::int_<E::value>());
+  }
+
+  template <class E>
+  typename std::enable_if<utils::is_splittable<E>::value, bool>::type
+  _any_par(E const &expr)
+  {
+    long n = expr.flat_size();
+    if (n < 2 * PYTHRAN_OPENMP_REDUCTION_BLOCK || !utils::no_broadcast(expr))
+      return _any(expr, utils::int_<E::value>());
+    long size = std::get<0>(expr.shape());
+    long row_size = n / size;
+    std::atomic<bool> found(false);
+    return utils::parallel_reduce<bool>(
+        size, std::max(1L, PYTHRAN_OPENMP_REDUCTION_BLOCK / row_size),
+        [&expr, &found](long lo, long hi) {
+          // another block already holds a true value
+          if (found.load(std::memory_order_relaxed))
+            return true;
+          bool res = _any(expr[types::contiguous_slice(lo, hi)],
+                          utils::int_<E::value>());
+          if (res)
+            found.store(true, std::memory_order_relaxed);
+          return res;
+        },
+        [](bool &self, bool other) { self = self || other; });
+  }
+#endif
+
   template <class E>
   typename std::enable_if<types::is_numexpr_arg<E>::value, bool>::type
   any(E const &expr, types::none_type)
   {
+#ifdef _OPENMP
+    return _any_par(expr);
+#else
     return _any(expr, utils::int_<E::value>());
+#endif
   }
 
   template <class E>
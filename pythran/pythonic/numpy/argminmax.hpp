@@ -5,6 +5,7 @@
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/numpy/asarray.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
+#include "pythonic/utils/parallel_reduce.hpp"
 
 PYTHONIC_NS_BEGIN
 
@@ -106,8 +107,11 @@ namespace numpy
       for (++viter; viter != vend; ++viter) {
         curr += step;
         auto c = *viter;
-        vacc = typename Op::op{}(vacc, c);
-        auto mask = c == vacc;
+        // only strict improvements, so that each lane keeps the first
+        // occurrence of its extremum
+        auto next = typename Op::op{}(vacc, c);
+        auto mask = next != vacc;
+        vacc = next;
         indices =
             xsimd::select(bool_caster<std::is_floating_point<T>::value>{}(mask),
                           curr, indices);
@@ -119,7 +123,9 @@ namespace numpy
       indices.store_aligned(&indexed[0]);
 
       for (size_t j = 0; j < vN; ++j) {
-        if (Op::value(stored[j], minmax_elts)) {
+        // on ties, the lane holding the lowest index wins
+        if (Op::value(stored[j], minmax_elts) ||
+            (stored[j] == minmax_elts && indexed[j] < minmax_index)) {
           minmax_elts = stored[j];
           minmax_index = indexed[j];
         }
@@ -152,12 +158,8 @@ namespace numpy
   }
 
   template <class Op, class E>
-  long argminmax(E const &expr)
+  long _argminmax_flat(E const &expr, typename E::dtype &argminmax_value)
   {
-    if (!expr.flat_size())
-      throw types::ValueError("empty sequence");
-    using elt_type = typename E::dtype;
-    elt_type argminmax_value = Op::limit();
 #ifndef USE_XSIMD
     if (utils::no_broadcast(expr))
       return _argminmax<Op>(types::make_fast_range(expr), argminmax_value,
@@ -167,6 +169,61 @@ namespace numpy
       return _argminmax<Op>(expr, argminmax_value, utils::int_<E::value>());
   }
 
+#ifdef _OPENMP
+  template <class Op, class E>
+  typename std::enable_if<!utils::is_splittable<E>::value, long>::type
+  _argminmax_par(E const &expr)
+  {
+    typename E::dtype argminmax_value = Op::limit();
+    return _argminmax_flat<Op>(expr, argminmax_value);
+  }
+
+  template <class Op, class E>
+  typename std::enable_if<utils::is_splittable<E>::value, long>::type
+  _argminmax_par(E const &expr)
+  {
+    using elt_type = typename E::dtype;
+    long n = expr.flat_size();
+    if (n < 2 * PYTHRAN_OPENMP_REDUCTION_BLOCK || !utils::no_broadcast(expr)) {
+      elt_type argminmax_value = Op::limit();
+      return _argminmax_flat<Op>(expr, argminmax_value);
+    }
+    long size = std::get<0>(expr.shape());
+    long row_size = n / size;
+    // (extremum, flat index) of each block of rows, merged in order so that
+    // the first occurrence wins, as in the sequential version
+    using partial = std::pair<elt_type, long>;
+    return utils::parallel_reduce<partial>(
+               size, std::max(1L, PYTHRAN_OPENMP_REDUCTION_BLOCK / row_size),
+               [&expr, row_size](long lo, long hi) {
+                 partial res(Op::limit(), -1);
+                 long index = _argminmax_flat<Op>(
+                     expr[types::contiguous_slice(lo, hi)], res.first);
+                 if (index >= 0)
+                   res.second = lo * row_size + index;
+                 return res;
+               },
+               [](partial &self, partial const &other) {
+                 if (other.second >= 0 &&
+                     (self.second < 0 || Op::value(other.first, self.first)))
+                   self = other;
+               }).second;
+  }
+#endif
+
+  template <class Op, class E>
+  long argminmax(E const &expr)
+  {
+    if (!expr.flat_size())
+      throw types::ValueError("empty sequence");
+#ifdef _OPENMP
+    return _argminmax_par<Op>(expr);
+#else
+    typename E::dtype argminmax_value = Op::limit();
+    return _argminmax_flat<Op>(expr, argminmax_value);
+#endif
+  }
+
   template <class Op, size_t Dim, size_t Axis, class T, class E, class V>
   void _argminmax_tail(T &out, E const &expr, long curr, V &curr_minmax,
                        std::integral_constant<size_t, 0>)
@@ -0,0 +1,81 @@
+#ifndef PYTHONIC_NUMPY_ARGPARTITION_HPP
+#define PYTHONIC_NUMPY_ARGPARTITION_HPP
+
+#include "pythonic/include/numpy/argpartition.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/utils/sort.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/numpy/partition.hpp"
+
+#include <memory>
+#include <numeric>
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  namespace details
+  {
+    // (value, index) pairs are partitioned together, so that the values are
+    // read once
+    struct argpartition_kernel {
+      std::vector<long> const &kth;
+      template <class T>
+      void operator()(T const *lane, long *indices, long n) const
+      {
+        std::unique_ptr<std::pair<T, long>[]> items(
+            new std::pair<T, long>[n]);
+        for (long i = 0; i < n; ++i)
+          items[i] = std::pair<T, long>(lane[i], i);
+        partition_lane(items.get(), n, kth, utils::argsort_less<T>{});
+        for (long i = 0; i < n; ++i)
+          indices[i] = items[i].second;
+      }
+    };
+
+    template <class T, class pS, class K>
+    types::ndarray<long, pS> argpartition(types::ndarray<T, pS> const &a,
+                                          K const &kth, long axis)
+    {
+      constexpr long N = std::tuple_size<pS>::value;
+      if (axis < 0)
+        axis += N;
+      axis = axis % N;
+      auto a_shape = sutils::array(a.shape());
+      types::ndarray<long, pS> indices(a.shape(), __builtin__::None);
+      long const n = a_shape[axis];
+      std::vector<long> const positions = partition_kth(kth, n);
+      if (a.flat_size() == 0)
+        return indices;
+      long const inner =
+          std::accumulate(a_shape.begin() + axis + 1, a_shape.end(), 1L,
+                          std::multiplies<long>());
+      utils::map_lanes(a.buffer, indices.buffer, a.flat_size() / (n * inner),
+                       n, inner, argpartition_kernel{positions});
+      return indices;
+    }
+  }
+
+  template <class T, class pS, class K>
+  types::ndarray<long, pS> argpartition(types::ndarray<T, pS> const &a,
+                                        K const &kth, long axis)
+  {
+    return details::argpartition(a, kth, axis);
+  }
+
+  template <class T, class pS, class K>
+  types::ndarray<long, pS> argpartition(types::ndarray<T, pS> const &a,
+                                        K const &kth, long axis,
+                                        types::str const &kind)
+  {
+    details::partition_kind(kind);
+    return details::argpartition(a, kth, axis);
+  }
+
+  NUMPY_EXPR_TO_NDARRAY0_IMPL(argpartition);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -4,32 +4,129 @@
 #include "pythonic/include/numpy/argsort.hpp"
 
 #include "pythonic/utils/functor.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
 
 PYTHONIC_NS_BEGIN
 
 namespace numpy
 {
-  template <class T, class pS>
-  types::ndarray<long, pS> argsort(types::ndarray<T, pS> const &a)
+  namespace details
   {
-    constexpr auto N = std::tuple_size<pS>::value;
-    size_t last_axis = std::get<N - 1>(a.shape());
-    size_t n = a.flat_size();
-    types::ndarray<long, pS> indices(a.shape(), __builtin__::None);
-    for (long j = 0, *iter_indices = indices.buffer,
-              *end_indices = indices.buffer + n;
-         iter_indices != end_indices;
-         iter_indices += last_axis, j += last_axis) {
-      // fill with the original indices
-      std::iota(iter_indices, iter_indices + last_axis, 0L);
-      // sort the index using the value from a
-      std::sort(iter_indices, iter_indices + last_axis,
-                [&a, j](long i1, long i2) {
-                  return *(a.fbegin() + j + i1) < *(a.fbegin() + j + i2);
-                });
+    // (value, index) pairs are compared by value then by index, so every
+    // kind gives the stable argsort
+    enum class argsort_kind { quick, heap, stable };
+
+    inline argsort_kind argsort_kind_of(types::str const &kind)
+    {
+      if (kind == "quicksort")
+        return argsort_kind::quick;
+      else if (kind == "heapsort")
+        return argsort_kind::heap;
+      else if (kind == "mergesort" || kind == "stable")
+        return argsort_kind::stable;
+      else
+        throw types::ValueError("sort kind must be one of 'quick', 'heap', "
+                                "or 'stable'");
+    }
+
+    template <class T>
+    void argsort_pairs(T const *values, long *indices, long n,
+                       argsort_kind kind)
+    {
+      std::unique_ptr<std::pair<T, long>[]> items(new std::pair<T, long>[n]);
+      for (long i = 0; i < n; ++i)
+        items[i] = std::pair<T, long>(values[i], i);
+      if (kind == argsort_kind::heap) {
+        std::make_heap(items.get(), items.get() + n, utils::argsort_less<T>{});
+        std::sort_heap(items.get(), items.get() + n, utils::argsort_less<T>{});
+      } else
+        std::sort(items.get(), items.get() + n, utils::argsort_less<T>{});
+      for (long i = 0; i < n; ++i)
+        indices[i] = items[i].second;
+    }
+
+    template <class T>
+    void argsort_radix_or(T const *values, long *indices, long n,
+                          argsort_kind, std::true_type)
+    {
+      utils::radix_argsort(values, indices, n);
+    }
+
+    template <class T>
+    void argsort_radix_or(T const *values, long *indices, long n,
+                          argsort_kind kind, std::false_type)
+    {
+      argsort_pairs(values, indices, n, kind);
+    }
+
+    /* Store in indices[0:n] the argsort of values[0:n] */
+    template <class T>
+    void argsort_lane(T const *values, long *indices, long n,
+                      argsort_kind kind)
+    {
+      using radix_sortable =
+          std::integral_constant<bool, utils::radix_key<T>::value>;
+      if (kind == argsort_kind::heap)
+        argsort_pairs(values, indices, n, kind);
+      else if (n <= PYTHRAN_SHORT_SORT_SIZE)
+        utils::insertion_argsort(values, indices, n);
+      else if (kind == argsort_kind::stable)
+        argsort_radix_or(values, indices, n, kind, radix_sortable{});
+      else if (n >= PYTHRAN_RADIX_SORT_THRESHOLD)
+        argsort_radix_or(values, indices, n, kind, radix_sortable{});
+      else
+        argsort_pairs(values, indices, n, kind);
     }
-    return indices;
+
+    struct argsort_kernel {
+      argsort_kind kind;
+      template <class T>
+      void operator()(T const *lane, long *indices, long n) const
+      {
+        argsort_lane(lane, indices, n, kind);
+      }
+    };
+
+    template <class T, class pS>
+    types::ndarray<long, pS> argsort(types::ndarray<T, pS> const &a,
+                                     long axis, argsort_kind kind)
+    {
+      constexpr long N = std::tuple_size<pS>::value;
+      if (axis < 0)
+        axis += N;
+      axis = axis % N;
+      auto a_shape = sutils::array(a.shape());
+      types::ndarray<long, pS> indices(a.shape(), __builtin__::None);
+      long const n = a_shape[axis];
+      if (a.flat_size() == 0)
+        return indices;
+      long const inner =
+          std::accumulate(a_shape.begin() + axis + 1, a_shape.end(), 1L,
+                          std::multiplies<long>());
+      utils::map_lanes(a.buffer, indices.buffer, a.flat_size() / (n * inner),
+                       n, inner, argsort_kernel{kind});
+      return indices;
+    }
+  }
+
+  template <class T, class pS>
+  types::ndarray<long, pS> argsort(types::ndarray<T, pS> const &a, long axis)
+  {
+    return details::argsort(a, axis, details::argsort_kind::quick);
+  }
+
+  template <class T, class pS>
+  types::ndarray<long, pS> argsort(types::ndarray<T, pS> const &a, long axis,
+                                   types::str const &kind)
+  {
+    return details::argsort(a, axis, details::argsort_kind_of(kind));
   }
 
   NUMPY_EXPR_TO_NDARRAY0_IMPL(argsort);
@@ -6,11 +6,126 @@
 #include "pythonic/numpy/conjugate.hpp"
 #include "pythonic/numpy/asarray.hpp"
 #include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/fft/fftpack.hpp"
+
+#include <complex>
+#include <vector>
 
 PYTHONIC_NS_BEGIN
 
 namespace numpy
 {
+  namespace details
+  {
+    // Integer correlations stay on the exact, direct path.
+    template <class T>
+    struct fft_correlable
+        : std::integral_constant<bool, std::is_floating_point<T>::value ||
+                                           types::is_complex<T>::value> {
+    };
+
+    template <class T>
+    typename std::enable_if<!types::is_complex<T>::value, T>::type
+    from_fft(std::complex<double> const &v)
+    {
+      return v.real();
+    }
+    template <class T>
+    typename std::enable_if<types::is_complex<T>::value, T>::type
+    from_fft(std::complex<double> const &v)
+    {
+      return T(v.real(), v.imag());
+    }
+
+    // Pick the FFT size of the overlap-add: a power of two at least twice
+    // the number of taps, minimizing the FFT cost per output sample. There
+    // is no point in going beyond the size of a single-block transform.
+    inline long fft_correlate_size(long NA, long NB)
+    {
+      long single = 1;
+      while (single < NA + NB - 1)
+        single *= 2;
+      long best = 1;
+      while (best < 2 * NB - 1)
+        best *= 2;
+      double best_cost = best * std::log2(best) / (best - NB + 1);
+      for (long n = best * 2; n <= single; n *= 2) {
+        double cost = n * std::log2(n) / (n - NB + 1);
+        if (cost >= best_cost)
+          break;
+        best = n;
+        best_cost = cost;
+      }
+      return std::min(best, single);
+    }
+
+    // Overlap-add evaluation of
+    //   acc[k] = sum_j inA[start + k + j - NB + 1] * inB[j]
+    // that is the ``full'' correlation restricted to [start, start + outN).
+    // inB is turned into a reversed kernel, so that the correlation
+    // becomes a convolution with it. When both inputs are real, two
+    // consecutive blocks of inA are packed in the real and imaginary parts
+    // of a single complex transform.
+    template <class A, class B>
+    std::vector<std::complex<double>> fft_correlate(A const &inA, B const &inB,
+                                                    long NA, long NB,
+                                                    long start, long outN)
+    {
+      constexpr bool packed = !types::is_complex<typename A::dtype>::value &&
+                              !types::is_complex<typename B::dtype>::value;
+      long N = fft_correlate_size(NA, NB);
+      long L = N - NB + 1;
+
+      std::vector<double> wsave(4 * N + 15);
+      fft::npy_cffti(N, wsave.data());
+
+      std::vector<std::complex<double>> kernel(N);
+      for (long j = 0; j < NB; ++j)
+        kernel[NB - 1 - j] = inB.fast(j);
+      fft::npy_cfftf(N, reinterpret_cast<double *>(kernel.data()),
+                     wsave.data());
+      // fold the 1/N normalization of the backward transform in the kernel
+      for (auto &k : kernel)
+        k /= N;
+
+      std::vector<std::complex<double>> acc(outN);
+      std::vector<std::complex<double>> block(N);
+      long const stride = packed ? 2 * L : L;
+      for (long offset = 0; offset < NA; offset += stride) {
+        long n0 = std::min(L, NA - offset);
+        long n1 = packed ? std::max(0L, std::min(L, NA - offset - L)) : 0;
+        for (long k = 0; k < n0; ++k)
+          block[k] = inA.fast(offset + k);
+        std::fill(block.begin() + n0, block.end(), 0.);
+        for (long k = 0; k < n1; ++k)
+          block[k] +=
+              std::complex<double>(0., std::real(inA.fast(offset + L + k)));
+
+        double *data = reinterpret_cast<double *>(block.data());
+        fft::npy_cfftf(N, data, wsave.data());
+        for (long k = 0; k < N; ++k)
+          block[k] *= kernel[k];
+        fft::npy_cfftb(N, data, wsave.data());
+
+        // full correlation index of block[k] is offset + k
+        long first = std::max(offset, start);
+        long last = std::min(offset + n0 + NB - 1, start + outN);
+        if (packed)
+          for (long m = first; m < last; ++m)
+            acc[m - start] += block[m - offset].real();
+        else
+          for (long m = first; m < last; ++m)
+            acc[m - start] += block[m - offset];
+        if (n1) {
+          first = std::max(offset + L, start);
+          last = std::min(offset + L + n1 + NB - 1, start + outN);
+          for (long m = first; m < last; ++m)
+            acc[m - start] += block[m - offset - L].imag();
+        }
+      }
+      return acc;
+    }
+  }
 
   template <class A, class B, typename U>
   types::ndarray<typename A::dtype, types::pshape<long>>
@@ -52,6 +167,22 @@ namespace numpy
     if (out_inc == -1)
       out_ptr += outN - 1;
 
+    // For long correlations, an FFT-based overlap-add is O(NA log NB)
+    // instead of O(NA NB)
+    if (details::fft_correlable<out_type>::value &&
+        std::min<long>(NB, outN) >= PYTHRAN_CORRELATE_FFT_THRESHOLD) {
+      auto acc = details::fft_correlate(inA_, inB_, NA, NB, iLeft + NB - 1,
+                                        outN);
+      if (out_inc == 1)
+        for (long i = 0; i < outN; ++i, out_ptr++)
+          *out_ptr = details::from_fft<out_type>(acc[i]);
+      else
+        for (long i = 0; i < outN; ++i, out_ptr += out_inc)
+          *out_ptr =
+              wrapper::conjugate(details::from_fft<out_type>(acc[i]));
+      return out;
+    }
+
     // For small correlations, numpy uses small_correlate, far more efficient.
     // see numpy/core/src/multiarray/arraytypes.c.src
 
@@ -7,7 +7,14 @@
 #include "pythonic/numpy/sum.hpp"
 #include "pythonic/numpy/multiply.hpp"
 #include "pythonic/types/traits.hpp"
+#include "pythonic/utils/gemm.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
 
+#include <functional>
+
+#if defined(PYTHRAN_BLAS_NONE)
+#include "pythonic/utils/cblas.hpp"
+#else
 #if defined(PYTHRAN_BLAS_ATLAS) || defined(PYTHRAN_BLAS_SATLAS)
 extern "C" {
 #endif
@@ -15,6 +22,7 @@ extern "C" {
 #if defined(PYTHRAN_BLAS_ATLAS) || defined(PYTHRAN_BLAS_SATLAS)
 }
 #endif
+#endif
 
 PYTHONIC_NS_BEGIN
 
@@ -122,6 +130,195 @@ namespace numpy
     return out;
   }
 
+  namespace details
+  {
+    /* Operands that the in-tree kernels of utils/gemm.hpp can read in place,
+     * through a pointer and a pair of strides. Other expressions are
+     * evaluated first.
+     */
+    template <class E>
+    struct has_matrix_view : std::false_type {
+    };
+    template <class T, class pS>
+    struct has_matrix_view<types::ndarray<T, pS>>
+        : std::integral_constant<bool, std::tuple_size<pS>::value == 2> {
+    };
+    template <class T, class pS>
+    struct has_matrix_view<types::numpy_texpr<types::ndarray<T, pS>>>
+        : has_matrix_view<types::ndarray<T, pS>> {
+    };
+    template <class Arg>
+    struct has_matrix_view<types::numpy_iexpr<Arg>>
+        : std::integral_constant<
+              bool, types::is_ndarray<typename std::decay<Arg>::type>::value &&
+                        types::numpy_iexpr<Arg>::value == 2> {
+    };
+    template <class Arg, class... S>
+    struct has_matrix_view<types::numpy_gexpr<Arg, S...>>
+        : std::integral_constant<
+              bool, types::is_ndarray<typename std::decay<Arg>::type>::value &&
+                        std::decay<Arg>::type::value == 2 &&
+                        types::numpy_gexpr<Arg, S...>::value == 2> {
+    };
+
+    template <class E>
+    struct has_vector_view : std::false_type {
+    };
+    template <class T, class pS>
+    struct has_vector_view<types::ndarray<T, pS>>
+        : std::integral_constant<bool, std::tuple_size<pS>::value == 1> {
+    };
+    template <class Arg>
+    struct has_vector_view<types::numpy_iexpr<Arg>>
+        : std::integral_constant<
+              bool, types::is_ndarray<typename std::decay<Arg>::type>::value &&
+                        types::numpy_iexpr<Arg>::value == 1> {
+    };
+    template <class Arg, class S>
+    struct has_vector_view<types::numpy_gexpr<Arg, S>>
+        : std::integral_constant<
+              bool, types::is_ndarray<typename std::decay<Arg>::type>::value &&
+                        std::decay<Arg>::type::value == 1> {
+    };
+
+    template <class T, class pS>
+    utils::matrix_view<T> make_matrix_view(types::ndarray<T, pS> const &a)
+    {
+      return {a.buffer, std::get<1>(a.shape()), 1};
+    }
+    template <class T, class pS>
+    utils::matrix_view<T>
+    make_matrix_view(types::numpy_texpr<types::ndarray<T, pS>> const &a)
+    {
+      return make_matrix_view(a.arg).transpose();
+    }
+    template <class Arg>
+    utils::matrix_view<typename types::numpy_iexpr<Arg>::dtype>
+    make_matrix_view(types::numpy_iexpr<Arg> const &a)
+    {
+      return {a.buffer, std::get<1>(a.shape()), 1};
+    }
+    template <class Arg, class S0>
+    utils::matrix_view<typename types::numpy_gexpr<Arg, S0>::dtype>
+    make_matrix_view(types::numpy_gexpr<Arg, S0> const &a)
+    {
+      return {a.buffer, std::get<1>(a.arg.shape()) * std::get<0>(a.slices).step,
+              1};
+    }
+    template <class Arg, class S0, class S1>
+    utils::matrix_view<typename types::numpy_gexpr<Arg, S0, S1>::dtype>
+    make_matrix_view(types::numpy_gexpr<Arg, S0, S1> const &a)
+    {
+      // buffer only accounts for the lower bound of the leading slice
+      return {a.buffer + std::get<1>(a.slices).lower,
+              std::get<1>(a.arg.shape()) * std::get<0>(a.slices).step,
+              std::get<1>(a.slices).step};
+    }
+
+    template <class T, class pS>
+    utils::vector_view<T> make_vector_view(types::ndarray<T, pS> const &a)
+    {
+      return {a.buffer, 1};
+    }
+    template <class Arg>
+    utils::vector_view<typename types::numpy_iexpr<Arg>::dtype>
+    make_vector_view(types::numpy_iexpr<Arg> const &a)
+    {
+      return {a.buffer, 1};
+    }
+    template <class Arg, class S>
+    utils::vector_view<typename types::numpy_gexpr<Arg, S>::dtype>
+    make_vector_view(types::numpy_gexpr<Arg, S> const &a)
+    {
+      return {a.buffer, std::get<0>(a.slices).step};
+    }
+
+    template <class E>
+    typename std::enable_if<has_matrix_view<E>::value, E const &>::type
+    as_matrix(E const &e)
+    {
+      return e;
+    }
+    template <class E>
+    typename std::enable_if<
+        !has_matrix_view<E>::value,
+        types::ndarray<typename E::dtype, types::array<long, 2>>>::type
+    as_matrix(E const &e)
+    {
+      return e;
+    }
+
+    template <class E>
+    typename std::enable_if<has_vector_view<E>::value, E const &>::type
+    as_vector(E const &e)
+    {
+      return e;
+    }
+    template <class E>
+    typename std::enable_if<
+        !has_vector_view<E>::value,
+        types::ndarray<typename E::dtype, types::pshape<long>>>::type
+    as_vector(E const &e)
+    {
+      return e;
+    }
+
+    template <class T, class E, class F>
+    void dot_mv(E const &e, F const &f, T *out)
+    {
+      utils::gemv(std::get<0>(e.shape()), std::get<1>(e.shape()),
+                  make_matrix_view(e), make_vector_view(f), out);
+    }
+
+    template <class T, class E, class F>
+    void dot_vm(E const &e, F const &f, T *out)
+    {
+      utils::gemv(std::get<1>(f.shape()), std::get<0>(f.shape()),
+                  make_matrix_view(f).transpose(), make_vector_view(e), out);
+    }
+
+    template <class T, class E, class F>
+    void dot_mm(E const &e, F const &f, T *out)
+    {
+      utils::gemm(std::get<0>(e.shape()), std::get<1>(f.shape()),
+                  std::get<1>(e.shape()), make_matrix_view(e),
+                  make_matrix_view(f), out);
+    }
+
+    template <class E, class F, class T, class pS>
+    void check_dot_out(E const &e, F const &f,
+                       types::ndarray<T, pS> const &c)
+    {
+      if (std::get<0>(c.shape()) != std::get<0>(e.shape()) ||
+          std::get<1>(c.shape()) != std::get<1>(f.shape()))
+        throw types::ValueError("output array has wrong dimensions");
+    }
+
+    /* Whether an operand, read through its matrix view, shares memory with
+     * the `size` elements at `out`. The product then goes through a
+     * temporary, as in numpy, instead of reading values already
+     * overwritten.
+     */
+    template <class E, class T>
+    bool overlaps(E const &e, T const *out, long size)
+    {
+      long rows = std::get<0>(e.shape()), cols = std::get<1>(e.shape());
+      if (!rows || !cols || !size)
+        return false;
+      auto view = make_matrix_view(e);
+      long rspan = (rows - 1) * view.row_stride,
+           cspan = (cols - 1) * view.col_stride;
+      auto first = reinterpret_cast<char const *>(
+          view.data + std::min(0L, rspan) + std::min(0L, cspan));
+      auto last = reinterpret_cast<char const *>(
+          view.data + std::max(0L, rspan) + std::max(0L, cspan) + 1);
+      // std::less orders unrelated pointers too
+      std::less<char const *> before;
+      return before(first, reinterpret_cast<char const *>(out + size)) &&
+             before(reinterpret_cast<char const *>(out), last);
+    }
+  }
+
 /// Matrice / Vector multiplication
 
 #define MV_DEF(T, L)                                                           \
@@ -248,8 +445,8 @@ namespace numpy
     return dot(e_, f_);
   }
 
-  // If one of the arg doesn't have a "blas compatible type", we use a slow
-  // matrix vector multiplication.
+  // If one of the arg doesn't have a "blas compatible type", we use the
+  // in-tree matrix vector multiplication.
   template <class E, class F>
   typename std::enable_if<
       (!is_blas_type<typename E::dtype>::value ||
@@ -260,18 +457,15 @@ namespace numpy
           types::pshape<long>>>::type
   dot(E const &e, F const &f)
   {
-    types::ndarray<
-        typename __combined<typename E::dtype, typename F::dtype>::type,
-        types::pshape<long>>
-    out(types::pshape<long>{std::get<1>(f.shape())}, 0);
-    for (long i = 0; i < std::get<0>(out.shape()); i++)
-      for (long j = 0; j < std::get<0>(f.shape()); j++)
-        out[i] += e[j] * f[types::array<long, 2>{{j, i}}];
+    using T = typename __combined<typename E::dtype, typename F::dtype>::type;
+    types::ndarray<T, types::pshape<long>> out(
+        types::pshape<long>{std::get<1>(f.shape())}, __builtin__::None);
+    details::dot_vm(details::as_vector(e), details::as_matrix(f), out.buffer);
     return out;
   }
 
-  // If one of the arg doesn't have a "blas compatible type", we use a slow
-  // matrix vector multiplication.
+  // If one of the arg doesn't have a "blas compatible type", we use the
+  // in-tree matrix vector multiplication.
   template <class E, class F>
   typename std::enable_if<
       (!is_blas_type<typename E::dtype>::value ||
@@ -282,13 +476,10 @@ namespace numpy
           types::pshape<long>>>::type
   dot(E const &e, F const &f)
   {
-    types::ndarray<
-        typename __combined<typename E::dtype, typename F::dtype>::type,
-        types::pshape<long>>
-    out(types::pshape<long>{std::get<0>(e.shape())}, 0);
-    for (long i = 0; i < std::get<0>(out.shape()); i++)
-      for (long j = 0; j < std::get<0>(f.shape()); j++)
-        out[i] += e[types::array<long, 2>{{i, j}}] * f[j];
+    using T = typename __combined<typename E::dtype, typename F::dtype>::type;
+    types::ndarray<T, types::pshape<long>> out(
+        types::pshape<long>{std::get<0>(e.shape())}, __builtin__::None);
+    details::dot_mv(details::as_matrix(e), details::as_vector(f), out.buffer);
     return out;
   }
 
@@ -334,10 +525,17 @@ namespace numpy
   typename std::enable_if<
       is_blas_type<E>::value && std::tuple_size<pS0>::value == 2 &&
           std::tuple_size<pS1>::value == 2 && std::tuple_size<pS2>::value == 2,
-      types::ndarray<E, pS2>>::type &
+      types::ndarray<E, pS2>>::type
   dot(types::ndarray<E, pS0> const &a, types::ndarray<E, pS1> const &b,
-      types::ndarray<E, pS2> &c)
+      types::ndarray<E, pS2> c)
   {
+    details::check_dot_out(a, b, c);
+    if (details::overlaps(a, c.buffer, c.flat_size()) ||
+        details::overlaps(b, c.buffer, c.flat_size())) {
+      auto tmp = dot(a, b);
+      std::copy(tmp.buffer, tmp.buffer + tmp.flat_size(), c.buffer);
+      return c;
+    }
     int n = std::get<1>(b.shape()), m = std::get<0>(a.shape()),
         k = std::get<0>(b.shape());
 
@@ -482,8 +680,8 @@ namespace numpy
     return dot(e_, f_);
   }
 
-  // If one of the arg doesn't have a "blas compatible type", we use a slow
-  // matrix multiplication.
+  // If one of the arg doesn't have a "blas compatible type", we use the
+  // in-tree matrix multiplication.
   template <class E, class F>
   typename std::enable_if<
       (!is_blas_type<typename E::dtype>::value ||
@@ -494,19 +692,37 @@ namespace numpy
           types::array<long, 2>>>::type
   dot(E const &e, F const &f)
   {
-    types::ndarray<
-        typename __combined<typename E::dtype, typename F::dtype>::type,
-        types::array<long, 2>>
-    out(types::array<long, 2>{{std::get<0>(e.shape()), std::get<1>(f.shape())}},
-        0);
-    for (long i = 0; i < std::get<0>(out.shape()); i++)
-      for (long j = 0; j < std::get<1>(out.shape()); j++)
-        for (long k = 0; k < std::get<1>(e.shape()); k++)
-          out[types::array<long, 2>{{i, j}}] +=
-              e[types::array<long, 2>{{i, k}}] *
-              f[types::array<long, 2>{{k, j}}];
+    using T = typename __combined<typename E::dtype, typename F::dtype>::type;
+    types::ndarray<T, types::array<long, 2>> out(
+        types::array<long, 2>{{std::get<0>(e.shape()), std::get<1>(f.shape())}},
+        __builtin__::None);
+    details::dot_mm(details::as_matrix(e), details::as_matrix(f), out.buffer);
     return out;
   }
+
+  template <class E, class F, class T, class pS>
+  typename std::enable_if<(!is_blas_type<typename E::dtype>::value ||
+                           !is_blas_type<typename F::dtype>::value) &&
+                              E::value == 2 && F::value == 2 &&
+                              std::tuple_size<pS>::value == 2,
+                          types::ndarray<T, pS>>::type
+  dot(E const &e, F const &f, types::ndarray<T, pS> c)
+  {
+    details::check_dot_out(e, f, c);
+    auto const &e_ = details::as_matrix(e);
+    auto const &f_ = details::as_matrix(f);
+    if (details::overlaps(e_, c.buffer, c.flat_size()) ||
+        details::overlaps(f_, c.buffer, c.flat_size())) {
+      types::ndarray<T, types::array<long, 2>> tmp(
+          types::array<long, 2>{
+              {std::get<0>(c.shape()), std::get<1>(c.shape())}},
+          __builtin__::None);
+      details::dot_mm(e_, f_, tmp.buffer);
+      std::copy(tmp.buffer, tmp.buffer + tmp.flat_size(), c.buffer);
+    } else
+      details::dot_mm(e_, f_, c.buffer);
+    return c;
+  }
 }
 PYTHONIC_NS_END
 
@@ -11,6 +11,11 @@
 
 #define ref(u, a) u[a]
 
+/* Only provided by numpy headers, which are not there in standalone mode. */
+#ifndef NPY_VISIBILITY_HIDDEN
+#define NPY_VISIBILITY_HIDDEN
+#endif
+
 /* Macros for accurate calculation of the twiddle factors. */
 #define TWOPI 6.283185307179586476925286766559005768391
 #define cos2pi(m, n) cos((TWOPI * (m)) / (n))
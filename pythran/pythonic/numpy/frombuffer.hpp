@@ -0,0 +1,41 @@
+#ifndef PYTHONIC_NUMPY_FROMBUFFER_HPP
+#define PYTHONIC_NUMPY_FROMBUFFER_HPP
+
+#include "pythonic/include/numpy/frombuffer.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <cstring>
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  template <class dtype>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  frombuffer(types::str const &buffer, dtype d, long count, long offset)
+  {
+    using T = typename dtype::type;
+    if (offset < 0 || offset > buffer.size())
+      throw types::ValueError(
+          "offset must be non-negative and no greater than buffer length");
+    long available = buffer.size() - offset;
+    if (count < 0) {
+      if (available % sizeof(T))
+        throw types::ValueError("buffer size must be a multiple of element "
+                                "size");
+      count = available / sizeof(T);
+    } else if (count * sizeof(T) > size_t(available))
+      throw types::ValueError("buffer is smaller than requested size");
+    types::ndarray<T, types::pshape<long>> res(types::pshape<long>(count),
+                                               __builtin__::None);
+    memcpy(res.buffer, buffer.raw() + offset, count * sizeof(T));
+    return res;
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef PYTHONIC_NUMPY_FROMFILE_HPP
+#define PYTHONIC_NUMPY_FROMFILE_HPP
+
+#include "pythonic/include/numpy/fromfile.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/file.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/numpy/frombuffer.hpp"
+#include "pythonic/numpy/fromstring.hpp"
+
+#include <sys/stat.h>
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  template <class dtype>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  fromfile(types::file f, dtype d, long count, types::str const &sep,
+           long offset)
+  {
+    using T = typename dtype::type;
+    if (offset)
+      f.seek(offset, SEEK_CUR);
+    if (sep)
+      return fromstring(f.read(), d, count, sep);
+
+    struct stat st;
+    if (!fstat(f.fileno(), &st) && S_ISREG(st.st_mode)) {
+      long available = std::max(0L, long(st.st_size) - f.tell()) / sizeof(T);
+      count = count < 0 ? available : std::min(count, available);
+    } else if (count < 0) {
+      // unknown size, read until the end
+      types::str content = f.read();
+      return frombuffer(content, d, content.size() / sizeof(T));
+    }
+    // read straight into the array memory
+    utils::shared_ref<types::raw_array<T>> mem(count);
+    long n = f.readinto(reinterpret_cast<char *>(mem->data), count * sizeof(T));
+    return {mem, types::pshape<long>(n / sizeof(T))};
+  }
+
+  template <class dtype>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  fromfile(types::str const &filename, dtype d, long count,
+           types::str const &sep, long offset)
+  {
+    return fromfile(types::file(filename, "rb"), d, count, sep, offset);
+  }
+}
+PYTHONIC_NS_END
+
+#endif
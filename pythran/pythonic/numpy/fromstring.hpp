@@ -46,7 +46,7 @@ namespace numpy
       utils::shared_ref<types::raw_array<typename dtype::type>> buffer(
           std::get<0>(shape));
       auto const *tstring =
-          reinterpret_cast<typename dtype::type const *>(string.c_str());
+          reinterpret_cast<typename dtype::type const *>(string.raw());
       std::copy(tstring, tstring + std::get<0>(shape), buffer->data);
       return {buffer, shape};
     }
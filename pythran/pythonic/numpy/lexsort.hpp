@@ -4,7 +4,14 @@
 #include "pythonic/include/numpy/lexsort.hpp"
 
 #include "pythonic/utils/functor.hpp"
+#include "pythonic/utils/seq.hpp"
+#include "pythonic/utils/sort.hpp"
 #include "pythonic/types/ndarray.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
 
 PYTHONIC_NS_BEGIN
 
@@ -14,52 +21,142 @@ namespace numpy
   namespace details
   {
 
+    // compares the keys of two elements zipped in a tuple, last key first
     template <size_t I>
-    struct lexcmp_nth {
-      template <class K>
-      bool operator()(K const &keys, long i0, long i1) const
+    struct lexzip_less_nth {
+      template <class Z>
+      bool operator()(Z const &i, Z const &j) const
       {
-        if (std::get<I - 1>(keys)[i0] < std::get<I - 1>(keys)[i1])
+        utils::sort_less<typename std::tuple_element<I - 1, Z>::type> less;
+        if (less(std::get<I - 1>(i), std::get<I - 1>(j)))
           return true;
-        else if (std::get<I - 1>(keys)[i0] > std::get<I - 1>(keys)[i1])
+        else if (less(std::get<I - 1>(j), std::get<I - 1>(i)))
           return false;
         else
-          return lexcmp_nth<I - 1>{}(keys, i0, i1);
+          return lexzip_less_nth<I - 1>{}(i, j);
       }
     };
     template <>
-    struct lexcmp_nth<0> {
-      template <class K>
-      bool operator()(K const &keys, long i0, long i1) const
+    struct lexzip_less_nth<0> {
+      template <class Z>
+      bool operator()(Z const &i, Z const &j) const
       {
         return false;
       }
     };
 
-    template <class K>
-    struct lexcmp {
-      K const &keys;
-      lexcmp(K const &keys) : keys(keys)
+    // ties are broken by index, as lexsort is stable
+    template <class Z>
+    struct lexzip_less {
+      bool operator()(std::pair<Z, long> const &i,
+                      std::pair<Z, long> const &j) const
       {
+        lexzip_less_nth<std::tuple_size<Z>::value> less;
+        return less(i.first, j.first) ||
+               (!less(j.first, i.first) && i.second < j.second);
       }
-      bool operator()(long i0, long i1)
+    };
+
+    struct lexsort_kernel {
+      template <class Z>
+      void operator()(Z const *lane, long *indices, long n) const
       {
-        return lexcmp_nth<std::tuple_size<K>::value>{}(keys, i0, i1);
+        std::unique_ptr<std::pair<Z, long>[]> items(new std::pair<Z, long>[n]);
+        for (long i = 0; i < n; ++i)
+          items[i] = std::pair<Z, long>(lane[i], i);
+        std::sort(items.get(), items.get() + n, lexzip_less<Z>{});
+        for (long i = 0; i < n; ++i)
+          indices[i] = items[i].second;
       }
     };
+
+    template <class K>
+    types::ndarray<typename K::dtype, typename K::shape_t>
+    lexsort_array(K const &key)
+    {
+      return types::ndarray<typename K::dtype, typename K::shape_t>(key);
+    }
+
+    template <class pS, size_t... Is>
+    types::ndarray<long, types::pshape<long>>
+    lexsort1d(pS const &keys, long axis, utils::index_sequence<Is...>)
+    {
+      using zip_type = std::tuple<typename std::decay<decltype(
+          std::get<Is>(keys)[0])>::type...>;
+      long const size = std::get<0>(keys).size();
+      long const sizes[] = {(long)std::get<Is>(keys).size()...};
+      if (std::count(std::begin(sizes), std::end(sizes), size) !=
+          sizeof...(Is))
+        throw types::ValueError("all keys need to be the same shape");
+      if (axis != 0 && axis != -1)
+        throw types::ValueError("axis out of bounds");
+
+      types::ndarray<long, types::pshape<long>> out(
+          types::pshape<long>(size), __builtin__::None);
+      std::unique_ptr<zip_type[]> zipped(new zip_type[size]);
+      for (long i = 0; i < size; ++i)
+        zipped[i] = zip_type(std::get<Is>(keys)[i]...);
+      lexsort_kernel{}(zipped.get(), out.buffer, size);
+      return out;
+    }
+
+    template <class pS, size_t... Is>
+    types::ndarray<long, types::array<long, lexsort_dims<pS>::value>>
+    lexsort(pS const &keys, long axis, utils::index_sequence<Is...>)
+    {
+      constexpr long N = lexsort_dims<pS>::value;
+      using zip_type = std::tuple<typename std::decay<decltype(
+          std::get<Is>(keys))>::type::dtype...>;
+      auto arrays = std::make_tuple(lexsort_array(std::get<Is>(keys))...);
+      auto shape = sutils::array(std::get<0>(arrays).shape());
+      long const size = std::get<0>(arrays).flat_size();
+      long const sizes[] = {std::get<Is>(arrays).flat_size()...};
+      if (std::count(std::begin(sizes), std::end(sizes), size) !=
+          sizeof...(Is))
+        throw types::ValueError("all keys need to be the same shape");
+
+      types::ndarray<long, types::array<long, N>> out(shape,
+                                                      __builtin__::None);
+      if (size == 0)
+        return out;
+      // keys are zipped, so that the sorting engine moves them together
+      std::unique_ptr<zip_type[]> zipped(new zip_type[size]);
+      for (long i = 0; i < size; ++i)
+        zipped[i] = zip_type(std::get<Is>(arrays).buffer[i]...);
+
+      if (axis < 0)
+        axis += N;
+      axis = axis % N;
+      long const n = shape[axis];
+      long const inner = std::accumulate(shape.begin() + axis + 1,
+                                         shape.end(), 1L,
+                                         std::multiplies<long>());
+      utils::map_lanes(zipped.get(), out.buffer, size / (n * inner), n, inner,
+                       lexsort_kernel{});
+      return out;
+    }
+  }
+
+  template <class pS>
+  typename std::enable_if<details::lexsort_dims<pS>::value == 1,
+                          types::ndarray<long, types::pshape<long>>>::type
+  lexsort(pS const &keys, long axis)
+  {
+    return details::lexsort1d(
+        keys, axis,
+        utils::make_index_sequence<std::tuple_size<pS>::value>());
   }
 
   template <class pS>
-  types::ndarray<long, types::pshape<long>> lexsort(pS const &keys)
+  typename std::enable_if<
+      (details::lexsort_dims<pS>::value > 1),
+      types::ndarray<long, types::array<long, details::lexsort_dims<
+                                                  pS>::value>>>::type
+  lexsort(pS const &keys, long axis)
   {
-    long n = std::get<0>(keys).size();
-    types::ndarray<long, types::pshape<long>> out(types::pshape<long>(n),
-                                                  __builtin__::None);
-    // fill with the original indices
-    std::iota(out.buffer, out.buffer + n, 0L);
-    // then sort using keys as the comparator
-    std::sort(out.buffer, out.buffer + n, details::lexcmp<pS>(keys));
-    return out;
+    return details::lexsort(
+        keys, axis,
+        utils::make_index_sequence<std::tuple_size<pS>::value>());
   }
 }
 PYTHONIC_NS_END
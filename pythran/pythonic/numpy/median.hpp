@@ -5,36 +5,219 @@
 
 #include "pythonic/utils/functor.hpp"
 #include "pythonic/types/ndarray.hpp"
-#include "pythonic/numpy/asarray.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+#include "pythonic/numpy/isnan.hpp"
 #include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
 
 PYTHONIC_NS_BEGIN
 
 namespace numpy
 {
-  template <class T, class pS>
-  decltype(std::declval<T>() + 1.) median(types::ndarray<T, pS> const &arr)
+  namespace details
+  {
+    template <class T>
+    median_type<T> _select_nan()
+    {
+      return std::numeric_limits<median_type<T>>::quiet_NaN();
+    }
+
+    template <class T>
+    bool _has_nan(T const *first, long n)
+    {
+      return std::any_of(first, first + n,
+                         [](T const &v) { return functor::isnan{}(v); });
+    }
+
+    // Average of the two middle values, found through two partial
+    // selections instead of a full sort.
+    template <class T>
+    median_type<T> _median_select(T *first, long n)
+    {
+      if (n == 0)
+        return _select_nan<T>();
+      long mid = n / 2;
+      std::nth_element(first, first + mid, first + n);
+      if (n % 2)
+        return first[mid];
+      T lower = *std::max_element(first, first + mid);
+      return (lower + first[mid]) / double(2);
+    }
+
+    // numpy's default ``linear'' interpolation between the two ranks
+    // surrounding q * (n - 1).
+    template <class T>
+    median_type<T> _quantile_select(T *first, long n, double q)
+    {
+      if (n == 0)
+        return _select_nan<T>();
+      double index = q * (n - 1);
+      long lo = index;
+      std::nth_element(first, first + lo, first + n);
+      double frac = index - lo;
+      if (frac == 0.)
+        return first[lo];
+      median_type<T> low = first[lo];
+      median_type<T> high = *std::min_element(first + lo + 1, first + n);
+      return low + (high - low) * frac;
+    }
+
+    template <class T>
+    median_type<T> median_kernel::operator()(T *first, long n) const
+    {
+      if (_has_nan(first, n))
+        return _select_nan<T>();
+      return _median_select(first, n);
+    }
+
+    template <class T>
+    median_type<T> nanmedian_kernel::operator()(T *first, long n) const
+    {
+      T *last = std::partition(first, first + n,
+                               [](T const &v) { return !functor::isnan{}(v); });
+      return _median_select(first, last - first);
+    }
+
+    template <class T>
+    median_type<T> quantile_kernel::operator()(T *first, long n) const
+    {
+      if (_has_nan(first, n))
+        return _select_nan<T>();
+      return _quantile_select(first, n, q);
+    }
+
+    /* Copy the elements of expr to out, out + stride, out + 2 * stride...
+     * reading through the expression itself, so that views are never
+     * materialized.
+     */
+    template <class E, class T>
+    T *_select_gather(E const &expr, T *out, long stride, utils::int_<1>)
+    {
+      for (auto value : expr) {
+        *out = value;
+        out += stride;
+      }
+      return out;
+    }
+
+    template <class E, class T, size_t N>
+    T *_select_gather(E const &expr, T *out, long stride, utils::int_<N>)
+    {
+      for (auto &&sub : expr)
+        out = _select_gather(sub, out, stride, utils::int_<N - 1>());
+      return out;
+    }
+
+    /* Apply the kernel on every lane along axis, writing results in row
+     * major order to out. Lanes along the last axis are gathered one by one
+     * in scratch; lanes along an outer axis are gathered transposed, a whole
+     * block at once, so that each of them ends up contiguous.
+     */
+    template <class E, class T, class K, class O>
+    O *_select_lanes(E const &expr, long axis, std::vector<T> &scratch,
+                     K const &kernel, O *out, utils::int_<1>)
+    {
+      long n = std::get<0>(expr.shape());
+      scratch.resize(n);
+      _select_gather(expr, scratch.data(), 1, utils::int_<1>());
+      *out = kernel(scratch.data(), n);
+      return out + 1;
+    }
+
+    template <class E, class T, class K, class O, size_t N>
+    O *_select_lanes(E const &expr, long axis, std::vector<T> &scratch,
+                     K const &kernel, O *out, utils::int_<N>)
+    {
+      if (axis == 0) {
+        auto shape = sutils::array(expr.shape());
+        long n = shape[0];
+        long rest = std::accumulate(shape.begin() + 1, shape.end(), 1L,
+                                    std::multiplies<long>());
+        scratch.resize(n * rest);
+        long i = 0;
+        for (auto &&sub : expr)
+          _select_gather(sub, scratch.data() + i++, n, utils::int_<N - 1>());
+        for (long j = 0; j < rest; ++j)
+          *out++ = kernel(scratch.data() + j * n, n);
+      } else {
+        for (auto &&sub : expr)
+          out = _select_lanes(sub, axis - 1, scratch, kernel, out,
+                              utils::int_<N - 1>());
+      }
+      return out;
+    }
+
+    template <class E, class K>
+    median_type<typename E::dtype> select(E const &expr, K const &kernel)
+    {
+      std::vector<typename E::dtype> scratch(expr.flat_size());
+      _select_gather(expr, scratch.data(), 1, utils::int_<E::value>());
+      return kernel(scratch.data(), scratch.size());
+    }
+
+    template <class E, class K>
+    typename std::enable_if<E::value == 1, median_axis_type<E>>::type
+    _select_axis(E const &expr, long axis, K const &kernel)
+    {
+      if (axis != 0 && axis != -1)
+        throw types::ValueError("axis out of bounds");
+      return select(expr, kernel);
+    }
+
+    template <class E, class K>
+    typename std::enable_if<E::value != 1, median_axis_type<E>>::type
+    _select_axis(E const &expr, long axis, K const &kernel)
+    {
+      constexpr long N = E::value;
+      if (axis < 0)
+        axis += N;
+      if (axis < 0 || axis >= N)
+        throw types::ValueError("axis out of bounds");
+
+      auto shape = sutils::array(expr.shape());
+      types::array<long, N - 1> out_shape;
+      std::copy(shape.begin(), shape.begin() + axis, out_shape.begin());
+      std::copy(shape.begin() + axis + 1, shape.end(),
+                out_shape.begin() + axis);
+      median_axis_type<E> out{out_shape, __builtin__::None};
+
+      std::vector<typename E::dtype> scratch;
+      _select_lanes(expr, axis, scratch, kernel, out.buffer,
+                    utils::int_<E::value>());
+      return out;
+    }
+
+    template <class E, class K>
+    median_axis_type<E> select(E const &expr, long axis, K const &kernel)
+    {
+      return _select_axis(expr, axis, kernel);
+    }
+  }
+
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_type<typename E::dtype>>::type
+  median(E const &arr, types::none_type)
   {
-    size_t n = arr.flat_size();
-    T *tmp = new T[n];
-    std::copy(arr.buffer, arr.buffer + n, tmp);
-    std::sort(tmp, tmp + n);
-    auto out = (tmp[n / 2] + tmp[(n - 1) / 2]) / double(2);
-    delete[] tmp;
-    return out;
+    return details::select(arr, details::median_kernel{});
   }
 
   template <class T, class pS>
-  decltype(std::declval<T>() + 1.) median(types::ndarray<T, pS> &&arr)
+  details::median_type<T> median(types::ndarray<T, pS> &&arr, types::none_type)
   {
-    size_t n = arr.flat_size();
-    T *tmp = arr.buffer;
-    std::sort(tmp, tmp + n);
-    auto out = (tmp[n / 2] + tmp[(n - 1) / 2]) / double(2);
-    return out;
+    // we own the temporary: select in place
+    return details::median_kernel{}(arr.buffer, arr.flat_size());
   }
 
-  NUMPY_EXPR_TO_NDARRAY0_IMPL(median);
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_axis_type<E>>::type
+  median(E const &arr, long axis)
+  {
+    return details::select(arr, axis, details::median_kernel{});
+  }
 }
 PYTHONIC_NS_END
 
@@ -0,0 +1,140 @@
+#ifndef PYTHONIC_NUMPY_MEMMAP_HPP
+#define PYTHONIC_NUMPY_MEMMAP_HPP
+
+#include "pythonic/include/numpy/memmap.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/types/NoneType.hpp"
+#include "pythonic/__builtin__/IOError.hpp"
+#include "pythonic/__builtin__/NotImplementedError.hpp"
+#include "pythonic/__builtin__/RuntimeError.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <cerrno>
+#include <cstring>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  namespace details
+  {
+    template <class T>
+    utils::shared_ref<types::raw_array<T>> map_file(types::str const &filename,
+                                                    types::str const &mode,
+                                                    long offset, long &count)
+    {
+#ifdef _WIN32
+      throw pythonic::__builtin__::NotImplementedError(
+          "memmap is ! supported on this platform");
+#else
+      int flags = O_RDWR, share = MAP_SHARED;
+      bool extend = true, writeable = true;
+      if (mode == "r" || mode == "readonly") {
+        // numpy gets a read-only array, but our code may still write to it,
+        // so writes go to private pages rather than fault
+        flags = O_RDONLY;
+        share = MAP_PRIVATE;
+        extend = writeable = false;
+      } else if (mode == "c" || mode == "copyonwrite") {
+        flags = O_RDONLY;
+        share = MAP_PRIVATE;
+        extend = false;
+      } else if (mode == "w+" || mode == "write") {
+        if (count < 0)
+          throw types::ValueError("shape must be given");
+        flags |= O_CREAT | O_TRUNC;
+      } else if (mode != "r+" && mode != "readwrite")
+        throw types::ValueError("mode must be one of ['r', 'c', 'r+', 'w+', "
+                                "'readonly', 'copyonwrite', 'readwrite', "
+                                "'write']");
+      if (offset < 0)
+        throw types::ValueError("offset must be non-negative");
+
+      int fd = open(filename.get_data().c_str(), flags, 0666);
+      if (fd == -1)
+        throw types::IOError("Couldn't open file " + filename);
+      struct stat st;
+      if (fstat(fd, &st)) {
+        close(fd);
+        throw types::RuntimeError(strerror(errno));
+      }
+      if (count < 0) {
+        long available = std::max(0L, long(st.st_size) - offset);
+        if (available % sizeof(T)) {
+          close(fd);
+          throw types::ValueError("Size of available data is not a multiple "
+                                  "of the data-type size.");
+        }
+        count = available / sizeof(T);
+      }
+      long end = offset + count * sizeof(T);
+      if (end > st.st_size) {
+        // writable mappings grow the file to the requested size, like numpy
+        if (!extend || ftruncate(fd, end)) {
+          close(fd);
+          throw types::ValueError("mmap length is greater than file size");
+        }
+      }
+      if (!count) {
+        close(fd);
+        throw types::ValueError("cannot mmap an empty file");
+      }
+
+      // mappings start on a page boundary
+      long base = offset - offset % sysconf(_SC_PAGESIZE);
+      size_t length = end - base;
+      void *mapping =
+          mmap(nullptr, length, PROT_READ | PROT_WRITE, share, fd, base);
+      close(fd);
+      if (mapping == MAP_FAILED)
+        throw types::RuntimeError(strerror(errno));
+      T *data = reinterpret_cast<T *>(static_cast<char *>(mapping) +
+                                      (offset - base));
+      return {data, mapping, length, writeable};
+#endif
+    }
+  }
+
+  template <class dtype>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  memmap(types::str const &filename, dtype d, types::str const &mode,
+         long offset, types::none_type)
+  {
+    long count = -1;
+    auto mem = details::map_file<typename dtype::type>(filename, mode, offset,
+                                                       count);
+    return {mem, types::pshape<long>(count)};
+  }
+
+  template <class dtype>
+  types::ndarray<typename dtype::type, types::pshape<long>>
+  memmap(types::str const &filename, dtype d, types::str const &mode,
+         long offset, long shape)
+  {
+    return memmap(filename, d, mode, offset, types::pshape<long>(shape));
+  }
+
+  template <class dtype, class pS>
+  types::ndarray<typename dtype::type, sutils::shape_t<pS>>
+  memmap(types::str const &filename, dtype d, types::str const &mode,
+         long offset, pS const &shape)
+  {
+    auto pshape = (sutils::shape_t<pS>)shape;
+    long count = sutils::prod(pshape);
+    auto mem = details::map_file<typename dtype::type>(filename, mode, offset,
+                                                       count);
+    return {mem, pshape};
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef PYTHONIC_NUMPY_NANMEDIAN_HPP
+#define PYTHONIC_NUMPY_NANMEDIAN_HPP
+
+#include "pythonic/include/numpy/nanmedian.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/numpy/median.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_type<typename E::dtype>>::type
+  nanmedian(E const &arr, types::none_type)
+  {
+    return details::select(arr, details::nanmedian_kernel{});
+  }
+
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_axis_type<E>>::type
+  nanmedian(E const &arr, long axis)
+  {
+    return details::select(arr, axis, details::nanmedian_kernel{});
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef PYTHONIC_NUMPY_NDARRAY_TOFILE_HPP
+#define PYTHONIC_NUMPY_NDARRAY_TOFILE_HPP
+
+#include "pythonic/include/numpy/ndarray/tofile.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/utils/numpy_conversion.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/file.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/types/NoneType.hpp"
+
+#include <boost/format.hpp>
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+
+  namespace ndarray
+  {
+    template <class T, class pS>
+    types::none_type tofile(types::ndarray<T, pS> const &expr, types::file f,
+                            types::str const &sep, types::str const &format)
+    {
+      if (!sep) {
+        // the array memory is written as is, without intermediate string
+        f.write(reinterpret_cast<char const *>(expr.buffer),
+                expr.flat_size() * sizeof(T));
+        return {};
+      }
+
+      // text output is formatted by chunks of PYTHRAN_FILE_BUFFER_SIZE
+      // characters, so that large arrays are never rendered in one piece
+      using printable_type =
+          typename std::conditional<std::is_integral<T>::value &&
+                                        sizeof(T) == 1,
+                                    int, T>::type;
+      boost::format const fmter(format.get_data());
+      std::string chunk;
+      for (long i = 0, n = expr.flat_size(); i < n; ++i) {
+        if (i)
+          chunk.append(sep.raw(), sep.size());
+        chunk += (boost::format(fmter) % printable_type(expr.buffer[i])).str();
+        if (chunk.size() >= PYTHRAN_FILE_BUFFER_SIZE) {
+          f.write(chunk.data(), chunk.size());
+          chunk.clear();
+        }
+      }
+      f.write(chunk.data(), chunk.size());
+      return {};
+    }
+
+    template <class T, class pS>
+    types::none_type tofile(types::ndarray<T, pS> const &expr,
+                            types::str const &filename, types::str const &sep,
+                            types::str const &format)
+    {
+      return tofile(expr, types::file(filename, "wb"), sep, format);
+    }
+
+    NUMPY_EXPR_TO_NDARRAY0_IMPL(tofile);
+  }
+}
+PYTHONIC_NS_END
+#endif
@@ -0,0 +1,114 @@
+#ifndef PYTHONIC_NUMPY_PARTITION_HPP
+#define PYTHONIC_NUMPY_PARTITION_HPP
+
+#include "pythonic/include/numpy/partition.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/utils/sort.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  namespace details
+  {
+    std::vector<long> partition_kth(long kth, long n)
+    {
+      if (kth < -n || kth >= n)
+        throw types::ValueError("kth(=" + std::to_string(kth) +
+                                ") out of bounds (" + std::to_string(n) +
+                                ")");
+      return {kth < 0 ? kth + n : kth};
+    }
+
+    template <class K>
+    std::vector<long> partition_kth(K const &kth, long n)
+    {
+      std::vector<long> positions;
+      for (long k : kth)
+        positions.push_back(partition_kth(k, n).front());
+      std::sort(positions.begin(), positions.end());
+      positions.erase(std::unique(positions.begin(), positions.end()),
+                      positions.end());
+      return positions;
+    }
+
+    void partition_kind(types::str const &kind)
+    {
+      if (!(kind == "introselect"))
+        throw types::ValueError("partition kind must be 'introselect'");
+    }
+
+    /* Rearrange first[0:n] so that the elements at the sorted positions kth
+     * are those of the sorted range, smaller elements coming before them &&
+     * larger ones after.
+     */
+    template <class T, class Less>
+    void partition_lane(T *first, long n, std::vector<long> const &kth,
+                        Less less)
+    {
+      T *begin = first;
+      for (long k : kth) {
+        utils::nth_element(begin, first + k, first + n, less);
+        begin = first + k + 1;
+      }
+    }
+
+    struct partition_kernel {
+      std::vector<long> const &kth;
+      template <class T>
+      void operator()(T *lane, long n) const
+      {
+        partition_lane(lane, n, kth, utils::sort_less<T>{});
+      }
+    };
+
+    template <class T, class pS, class K>
+    void partition(types::ndarray<T, pS> &out, K const &kth, long axis)
+    {
+      constexpr long N = std::tuple_size<pS>::value;
+      if (axis < 0)
+        axis += N;
+      axis = axis % N;
+      auto out_shape = sutils::array(out.shape());
+      long const n = out_shape[axis];
+      std::vector<long> const positions = partition_kth(kth, n);
+      if (out.flat_size() == 0)
+        return;
+      long const inner =
+          std::accumulate(out_shape.begin() + axis + 1, out_shape.end(), 1L,
+                          std::multiplies<long>());
+      utils::sort_lanes(out.buffer, out.flat_size() / (n * inner), n, inner,
+                        partition_kernel{positions});
+    }
+  }
+
+  template <class E, class K>
+  types::ndarray<typename E::dtype, types::array<long, E::value>>
+  partition(E const &expr, K const &kth, long axis)
+  {
+    auto out = expr.copy();
+    details::partition(out, kth, axis);
+    return out;
+  }
+
+  template <class E, class K>
+  types::ndarray<typename E::dtype, types::array<long, E::value>>
+  partition(E const &expr, K const &kth, long axis, types::str const &kind)
+  {
+    details::partition_kind(kind);
+    return partition(expr, kth, axis);
+  }
+
+  NUMPY_EXPR_TO_NDARRAY0_IMPL(partition);
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef PYTHONIC_NUMPY_PERCENTILE_HPP
+#define PYTHONIC_NUMPY_PERCENTILE_HPP
+
+#include "pythonic/include/numpy/percentile.hpp"
+
+#include "pythonic/utils/functor.hpp"
+#include "pythonic/types/ndarray.hpp"
+#include "pythonic/__builtin__/ValueError.hpp"
+#include "pythonic/numpy/median.hpp"
+
+PYTHONIC_NS_BEGIN
+
+namespace numpy
+{
+  namespace details
+  {
+    inline quantile_kernel _percentile_kernel(double q)
+    {
+      if (q < 0 || q > 100)
+        throw types::ValueError("percentile must be in the range [0, 100]");
+      return {q / 100.};
+    }
+  }
+
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_type<typename E::dtype>>::type
+  percentile(E const &arr, double q, types::none_type)
+  {
+    return details::select(arr, details::_percentile_kernel(q));
+  }
+
+  template <class E>
+  typename std::enable_if<types::is_array<E>::value,
+                          details::median_axis_type<E>>::type
+  percentile(E const &arr, double q, long axis)
+  {
+    return details::select(arr, axis, details::_percentile_kernel(q));
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_BATCHED_HPP
+#define PYTHONIC_NUMPY_RANDOM_BATCHED_HPP
+
+#include "pythonic/include/numpy/random/batched.hpp"
+#include "pythonic/numpy/random/generator.hpp"
+
+#ifdef USE_XSIMD
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+PYTHONIC_NS_BEGIN
+namespace numpy
+{
+  namespace random
+  {
+    namespace details
+    {
+      pcg_lanes::pcg_lanes(pcg &engine)
+      {
+        // sequenced, so that a seed gives the same lanes everywhere
+        uint64_t hi = engine();
+        uint64_t lo = engine();
+        uint64_t initstate = (hi << 32) | lo;
+        for (size_t l = 0; l < width; ++l) {
+          pcg lane(initstate, l);
+          state[l] = lane.state;
+          inc[l] = lane.inc;
+        }
+      }
+
+      static inline uint64_t _pcg_output(uint64_t oldstate)
+      {
+        uint32_t xorshifted = uint32_t(((oldstate >> 18u) ^ oldstate) >> 27u);
+        uint32_t rot = oldstate >> 59u;
+        return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+      }
+
+      void pcg_lanes::next(double *out, size_t n)
+      {
+        // work on local copies, which the vectorizer knows out cannot alias
+        uint64_t lane_state[width], lane_inc[width];
+        std::copy(state, state + width, lane_state);
+        std::copy(inc, inc + width, lane_inc);
+        for (size_t i = 0; i < n; i += width)
+          for (size_t l = 0; l < width; ++l) {
+            // two steps per lane, computed as pcg::operator() does
+            uint64_t s0 = lane_state[l];
+            uint64_t s1 = s0 * pcg::multiplier + lane_inc[l];
+            lane_state[l] = s1 * pcg::multiplier + lane_inc[l];
+            uint64_t word = (_pcg_output(s0) << 32) | _pcg_output(s1);
+            uint64_t bits = (word >> 12) | 0x3FF0000000000000ULL;
+            std::memcpy(out + i + l, &bits, sizeof(bits));
+          }
+        std::copy(lane_state, lane_state + width, state);
+      }
+
+      // number of uniform values drawn at once
+      static constexpr size_t batched_block = 512;
+
+      /* Draw [first, last) through transform(u, out), which maps a full
+       * block of values in [1, 2) to batched_block outputs. The last
+       * partial block goes through a scratch buffer.
+       */
+      template <class F>
+      void _batched_fill(pcg &engine, double *first, double *last,
+                         F const &transform)
+      {
+        pcg_lanes lanes(engine);
+        alignas(64) double u[batched_block];
+        for (; last - first >= (long)batched_block; first += batched_block) {
+          lanes.next(u, batched_block);
+          transform(u, first);
+        }
+        if (first != last) {
+          alignas(64) double tail[batched_block];
+          lanes.next(u, batched_block);
+          transform(u, tail);
+          std::copy(tail, tail + (last - first), first);
+        }
+      }
+
+      void uniform_kernel::operator()(pcg &engine, double *first,
+                                      double *last) const
+      {
+        using batch_type = xsimd::simd_type<double>;
+        constexpr size_t N = batch_type::size;
+        batch_type vlow(low), vrange(high - low), one(1.);
+        _batched_fill(engine, first, last, [&](double const *u, double *out) {
+          for (size_t i = 0; i < batched_block; i += N) {
+            batch_type x = xsimd::load_aligned(u + i);
+            ((x - one) * vrange + vlow).store_unaligned(out + i);
+          }
+        });
+      }
+
+      void normal_kernel::operator()(pcg &engine, double *first,
+                                     double *last) const
+      {
+        using batch_type = xsimd::simd_type<double>;
+        constexpr size_t N = batch_type::size;
+        constexpr size_t half = batched_block / 2;
+        batch_type vloc(loc), vscale(scale), one(1.), two(2.),
+            minus_two(-2.), two_pi(2. * M_PI);
+        _batched_fill(engine, first, last, [&](double const *u, double *out) {
+          // each pair of uniform values yields a pair of normal ones
+          for (size_t i = 0; i < half; i += N) {
+            batch_type u0 = xsimd::load_aligned(u + i);
+            batch_type u1 = xsimd::load_aligned(u + half + i);
+            // 2 - u0 lies in (0, 1], so that the logarithm stays finite
+            batch_type radius = xsimd::sqrt(minus_two * xsimd::log(two - u0));
+            batch_type sin, cos;
+            xsimd::sincos(two_pi * (u1 - one), sin, cos);
+            (radius * cos * vscale + vloc).store_unaligned(out + i);
+            (radius * sin * vscale + vloc).store_unaligned(out + half + i);
+          }
+        });
+      }
+
+      void exponential_kernel::operator()(pcg &engine, double *first,
+                                          double *last) const
+      {
+        using batch_type = xsimd::simd_type<double>;
+        constexpr size_t N = batch_type::size;
+        batch_type vscale(scale), two(2.);
+        _batched_fill(engine, first, last, [&](double const *u, double *out) {
+          for (size_t i = 0; i < batched_block; i += N) {
+            batch_type x = xsimd::load_aligned(u + i);
+            (-xsimd::log(two - x) * vscale).store_unaligned(out + i);
+          }
+        });
+      }
+    }
+  }
+}
+PYTHONIC_NS_END
+
+#endif
+
+#endif
@@ -2,6 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_BINOMIAL_HPP
 
 #include "pythonic/include/numpy/random/binomial.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/numpy_expr.hpp"
@@ -32,8 +33,7 @@ namespace numpy
       details::parameters_check(n, p);
       types::ndarray<long, pS> result{shape, types::none_type()};
       std::binomial_distribution<long> distribution{(long)n, p};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_BYTES_HPP
 
 #include "pythonic/include/numpy/random/bytes.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/str.hpp"
 #include "pythonic/utils/functor.hpp"
@@ -21,7 +21,8 @@ namespace numpy
       // dummy init + rewrite is faster than reserve && push_back
       types::str result(std::string(length, 0));
       std::uniform_int_distribution<long> distribution{0, 255};
-      std::generate(result.chars().begin(), result.chars().end(), [&]() {
+      char *chars = result.chars();
+      std::generate(chars, chars + length, [&]() {
         return static_cast<char>(distribution(details::generator));
       });
       return result;
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_CHOICE_HPP
 
 #include "pythonic/include/numpy/random/choice.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/__builtin__/NotImplementedError.hpp"
 #include "pythonic/numpy/random/randint.hpp"
@@ -32,8 +32,7 @@ namespace numpy
 
       types::ndarray<long, pS> result{shape, types::none_type()};
       std::discrete_distribution<long> distribution{p.begin(), p.end()};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
       return result;
     }
 
@@ -78,8 +77,10 @@ namespace numpy
 
       types::ndarray<typename T::dtype, pS> result{shape, types::none_type()};
       std::uniform_int_distribution<long> distribution{0, a.size() - 1};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return a[distribution(details::generator)]; });
+      details::generator.generate(
+          result.fbegin(), result.fend(), [&a, distribution]() mutable {
+            return a[distribution(details::generator)];
+          });
       return result;
     }
 
@@ -104,8 +105,10 @@ namespace numpy
 
       types::ndarray<typename T::dtype, pS> result{shape, types::none_type()};
       std::discrete_distribution<long> distribution{p.begin(), p.end()};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return a[distribution(details::generator)]; });
+      details::generator.generate(
+          result.fbegin(), result.fend(), [&a, distribution]() mutable {
+            return a[distribution(details::generator)];
+          });
       return result;
     }
 
@@ -1,7 +1,8 @@
 #ifndef PYTHONIC_NUMPY_RANDOM_EXPONENTIAL_HPP
 #define PYTHONIC_NUMPY_RANDOM_EXPONENTIAL_HPP
 
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/batched.hpp"
 #include "pythonic/include/numpy/random/exponential.hpp"
 
 #include "pythonic/types/NoneType.hpp"
@@ -22,9 +23,13 @@ namespace numpy
     types::ndarray<double, pS> exponential(double scale, pS const &shape)
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
+#ifdef USE_XSIMD
+      details::generator.fill_batched(result.fbegin(), result.fend(),
+                                      details::exponential_kernel{scale});
+#else
       std::exponential_distribution<float> distribution{1 / scale};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
+#endif
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_F_HPP
 
 #include "pythonic/include/numpy/random/f.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -24,10 +24,11 @@ namespace numpy
       types::ndarray<double, pS> result{shape, types::none_type()};
       std::chi_squared_distribution<double> distribution{dfnum};
       std::chi_squared_distribution<double> distribution2{dfden};
-      std::generate(result.fbegin(), result.fend(), [&]() {
-        return (distribution(details::generator) * dfden) /
-               (distribution2(details::generator) * dfnum);
-      });
+      details::generator.generate(
+          result.fbegin(), result.fend(), [=]() mutable {
+            return (distribution(details::generator) * dfden) /
+                   (distribution2(details::generator) * dfnum);
+          });
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_GAMMA_HPP
 
 #include "pythonic/include/numpy/random/gamma.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -24,8 +24,7 @@ namespace numpy
     {
       types::ndarray<double, pS> result{array_shape, types::none_type()};
       std::gamma_distribution<double> distribution{shape, scale};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
       return result;
     }
 
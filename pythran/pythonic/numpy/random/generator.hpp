@@ -0,0 +1,115 @@
+#ifndef PYTHONIC_NUMPY_RANDOM_GENERATOR_HPP
+#define PYTHONIC_NUMPY_RANDOM_GENERATOR_HPP
+
+#include "pythonic/include/numpy/random/generator.hpp"
+
+#include <algorithm>
+
+PYTHONIC_NS_BEGIN
+namespace numpy
+{
+  namespace random
+  {
+    namespace details
+    {
+      thread_streams::thread_streams(std::random_device &rd)
+          : master(rd), thread_seed(rd()), epoch(0)
+      {
+      }
+
+      thread_streams::local_stream &thread_streams::local()
+      {
+        static thread_local local_stream stream{pcg(), ~0UL, false};
+        return stream;
+      }
+
+      pcg &thread_streams::current()
+      {
+#ifdef _OPENMP
+        local_stream &stream = local();
+        if (stream.bound)
+          return stream.engine;
+        if (omp_in_parallel()) {
+          if (stream.epoch != epoch) {
+            // odd stream numbers, even ones are used by generate
+            stream.engine = pcg(thread_seed, 2 * omp_get_thread_num() + 1);
+            stream.epoch = epoch;
+          }
+          return stream.engine;
+        }
+#endif
+        return master;
+      }
+
+      void thread_streams::seed(uint64_t value)
+      {
+        master.seed(value);
+        thread_seed = value;
+        ++epoch;
+      }
+
+      thread_streams::result_type thread_streams::operator()()
+      {
+        return current()();
+      }
+
+      template <class I, class Body>
+      void thread_streams::split(I first, I last, Body const &body)
+      {
+#ifdef _OPENMP
+        long n = last - first;
+        long nchunks = omp_get_max_threads();
+        if (n >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT && nchunks > 1 &&
+            !omp_in_parallel()) {
+          // sequenced, so that a seed gives the same streams everywhere
+          uint64_t hi = master();
+          uint64_t lo = master();
+          uint64_t chunk_seed = (hi << 32) | lo;
+#pragma omp parallel for schedule(static)
+          for (long chunk = 0; chunk < nchunks; ++chunk) {
+            // bind current() to this chunk's stream while the body runs
+            local_stream &stream = local();
+            local_stream saved = stream;
+            stream.engine = pcg(chunk_seed, 2 * chunk);
+            stream.bound = true;
+            body(first + n * chunk / nchunks, first + n * (chunk + 1) / nchunks,
+                 stream.engine);
+            stream = saved;
+          }
+          return;
+        }
+#endif
+        body(first, last, current());
+      }
+
+      template <class I, class F>
+      void thread_streams::generate(I first, I last, F const &f)
+      {
+        split(first, last, [&f](I lo, I hi, pcg &) {
+          F g = f;
+          std::generate(lo, hi, g);
+        });
+      }
+
+      template <class I, class D>
+      void thread_streams::fill(I first, I last, D const &distribution)
+      {
+        // draw from the engine directly rather than through current()
+        split(first, last, [&distribution](I lo, I hi, pcg &engine) {
+          D d = distribution;
+          std::generate(lo, hi, [&]() { return d(engine); });
+        });
+      }
+
+      template <class T, class K>
+      void thread_streams::fill_batched(T *first, T *last, K const &kernel)
+      {
+        split(first, last,
+              [&kernel](T *lo, T *hi, pcg &engine) { kernel(engine, lo, hi); });
+      }
+    }
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_GUMBEL_HPP
 
 #include "pythonic/include/numpy/random/gumbel.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -22,8 +22,8 @@ namespace numpy
     types::ndarray<double, pS> gumbel(double loc, double scale, pS const &shape)
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return gumbel(loc, scale); });
+      details::generator.generate(result.fbegin(), result.fend(),
+                                  [&]() { return gumbel(loc, scale); });
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_LAPLACE_HPP
 
 #include "pythonic/include/numpy/random/laplace.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -23,8 +23,8 @@ namespace numpy
                                        pS const &shape)
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return laplace(loc, scale); });
+      details::generator.generate(result.fbegin(), result.fend(),
+                                  [&]() { return laplace(loc, scale); });
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_LOGISTIC_HPP
 
 #include "pythonic/include/numpy/random/logistic.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -23,8 +23,8 @@ namespace numpy
                                         pS const &shape)
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return logistic(loc, scale); });
+      details::generator.generate(result.fbegin(), result.fend(),
+                                  [&]() { return logistic(loc, scale); });
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_LOGNORMAL_HPP
 
 #include "pythonic/include/numpy/random/lognormal.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -24,8 +24,7 @@ namespace numpy
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
       std::lognormal_distribution<double> distribution{mean, sigma};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_LOGSERIES_HPP
 
 #include "pythonic/include/numpy/random/logseries.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -23,8 +23,8 @@ namespace numpy
     types::ndarray<double, pS> logseries(double p, pS const &shape)
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return logseries(p); });
+      details::generator.generate(result.fbegin(), result.fend(),
+                                  [&]() { return logseries(p); });
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_NEGATIVE_BINOMIAL_HPP
 
 #include "pythonic/include/numpy/random/negative_binomial.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -24,10 +24,11 @@ namespace numpy
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
       std::gamma_distribution<double> distribution_gamma{n, (1 - p) / p};
-      std::generate(result.fbegin(), result.fend(), [&]() {
-        return std::poisson_distribution<long>{
-            (distribution_gamma(details::generator))}(details::generator);
-      });
+      details::generator.generate(
+          result.fbegin(), result.fend(), [=]() mutable {
+            return std::poisson_distribution<long>{
+                (distribution_gamma(details::generator))}(details::generator);
+          });
       return result;
     }
 
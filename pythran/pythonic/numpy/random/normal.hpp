@@ -2,7 +2,8 @@
 #define PYTHONIC_NUMPY_RANDOM_NORMAL_HPP
 
 #include "pythonic/include/numpy/random/normal.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/batched.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -22,9 +23,13 @@ namespace numpy
     types::ndarray<double, pS> normal(double loc, double scale, pS const &shape)
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
+#ifdef USE_XSIMD
+      details::generator.fill_batched(result.fbegin(), result.fend(),
+                                      details::normal_kernel{loc, scale});
+#else
       std::normal_distribution<double> distribution{loc, scale};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
+#endif
       return result;
     }
 
@@ -1,7 +1,7 @@
 #ifndef PYTHONIC_NUMPY_RANDOM_PARETO_HPP
 #define PYTHONIC_NUMPY_RANDOM_PARETO_HPP
 
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 #include "pythonic/include/numpy/random/pareto.hpp"
 
 #include "pythonic/types/NoneType.hpp"
@@ -23,9 +23,10 @@ namespace numpy
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
       std::exponential_distribution<float> distribution{};
-      std::generate(result.fbegin(), result.fend(), [&]() {
-        return expm1(distribution(details::generator) / a);
-      });
+      details::generator.generate(
+          result.fbegin(), result.fend(), [=]() mutable {
+            return expm1(distribution(details::generator) / a);
+          });
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_POWER_HPP
 
 #include "pythonic/include/numpy/random/power.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -23,7 +23,8 @@ namespace numpy
     types::ndarray<double, pS> power(double a, pS const &shape)
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
-      std::generate(result.fbegin(), result.fend(), [&]() { return power(a); });
+      details::generator.generate(result.fbegin(), result.fend(),
+                                  [&]() { return power(a); });
 
       return result;
     }
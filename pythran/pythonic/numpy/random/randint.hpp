@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_RANDINT_HPP
 
 #include "pythonic/include/numpy/random/randint.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/tuple.hpp"
@@ -23,8 +23,7 @@ namespace numpy
     {
       types::ndarray<long, pS> result{shape, types::none_type()};
       std::uniform_int_distribution<long> distribution{min, max - 1};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
       return result;
     }
 
@@ -2,7 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_RAYLEIGH_HPP
 
 #include "pythonic/include/numpy/random/rayleigh.hpp"
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/NoneType.hpp"
@@ -23,8 +23,8 @@ namespace numpy
     types::ndarray<double, pS> rayleigh(double scale, pS const &array_shape)
     {
       types::ndarray<double, pS> result{array_shape, types::none_type()};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return rayleigh(scale); });
+      details::generator.generate(result.fbegin(), result.fend(),
+                                  [&]() { return rayleigh(scale); });
       return result;
     }
 
@@ -2,6 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_SEED_HPP
 
 #include "pythonic/include/numpy/random/seed.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 #include "pythonic/__builtin__/None.hpp"
 
 PYTHONIC_NS_BEGIN
@@ -2,6 +2,7 @@
 #define PYTHONIC_NUMPY_RANDOM_SHUFFLE_HPP
 
 #include "pythonic/include/numpy/random/shuffle.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/__builtin__/None.hpp"
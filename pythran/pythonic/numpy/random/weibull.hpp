@@ -1,7 +1,7 @@
 #ifndef PYTHONIC_NUMPY_RANDOM_WEIBULL_HPP
 #define PYTHONIC_NUMPY_RANDOM_WEIBULL_HPP
 
-#include "pythonic/include/numpy/random/generator.hpp"
+#include "pythonic/numpy/random/generator.hpp"
 #include "pythonic/include/numpy/random/weibull.hpp"
 
 #include "pythonic/types/NoneType.hpp"
@@ -23,8 +23,7 @@ namespace numpy
     {
       types::ndarray<double, pS> result{shape, types::none_type()};
       std::weibull_distribution<float> distribution{a};
-      std::generate(result.fbegin(), result.fend(),
-                    [&]() { return distribution(details::generator); });
+      details::generator.fill(result.fbegin(), result.fend(), distribution);
       return result;
     }
 
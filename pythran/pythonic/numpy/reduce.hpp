@@ -7,6 +7,7 @@
 #include "pythonic/__builtin__/None.hpp"
 #include "pythonic/__builtin__/ValueError.hpp"
 #include "pythonic/utils/neutral.hpp"
+#include "pythonic/utils/parallel_reduce.hpp"
 
 #ifdef USE_XSIMD
 #include <xsimd/xsimd.hpp>
@@ -149,10 +150,391 @@ namespace numpy
     }
   };
 
+  namespace details
+  {
+    /* Summation of floating point values, numpy style: blocks of at most
+     * 128 elements are summed through eight independent accumulators, and
+     * the block sums are added along a binary tree, which bounds the
+     * rounding error by O(log(n)) instead of O(n). Elements are added in
+     * the same order as numpy does, so that results match to the last bit.
+     *
+     * When PYTHRAN_KAHAN_SUMMATION is defined, the accumulators and the
+     * nodes of the tree are compensated instead, which makes the error
+     * independent of n.
+     */
+    constexpr long pairwise_block = 128;
+    constexpr long pairwise_accumulators = 8;
+
+#ifdef PYTHRAN_KAHAN_SUMMATION
+    // the summed value is sum - comp
+    template <class T>
+    struct pairwise_kahan {
+      T sum = 0, comp = 0;
+      pairwise_kahan &operator+=(T value)
+      {
+        T y = value - comp;
+        T t = sum + y;
+        comp = (t - sum) - y;
+        sum = t;
+        return *this;
+      }
+      // the rounding error of the addition is exactly err
+      friend pairwise_kahan operator+(pairwise_kahan const &left,
+                                      pairwise_kahan const &right)
+      {
+        pairwise_kahan res;
+        res.sum = left.sum + right.sum;
+        T b = res.sum - left.sum;
+        T err = (left.sum - (res.sum - b)) + (right.sum - b);
+        res.comp = (left.comp + right.comp) - err;
+        return res;
+      }
+      operator T() const
+      {
+        return sum - comp;
+      }
+    };
+
+    template <class T>
+    using pairwise_result = pairwise_kahan<T>;
+#else
+    template <class T>
+    using pairwise_result = T;
+#endif
+
+    template <class V>
+    struct pairwise_lanes {
+      static const long size = 1;
+      static V load(V const *data)
+      {
+        return *data;
+      }
+      static void store(V value, V *data)
+      {
+        *data = value;
+      }
+    };
+
+#ifdef USE_XSIMD
+    template <class T, size_t N>
+    struct pairwise_lanes<xsimd::batch<T, N>> {
+      static const long size = N;
+      static xsimd::batch<T, N> load(T const *data)
+      {
+        xsimd::batch<T, N> value;
+        value.load_unaligned(data);
+        return value;
+      }
+      static void store(xsimd::batch<T, N> const &value, T *data)
+      {
+        value.store_unaligned(data);
+      }
+    };
+
+    // each lane is one of the accumulators, so there are at most eight
+    template <class T, size_t N = xsimd::simd_traits<T>::size>
+    struct pairwise_vector_type {
+      using type = xsimd::batch<
+          T, (N < (size_t)pairwise_accumulators ? N
+                                                : (size_t)pairwise_accumulators)>;
+    };
+
+    template <class T>
+    struct pairwise_vector_type<T, 1> {
+      using type = T;
+    };
+
+    template <class T>
+    using pairwise_vector = typename pairwise_vector_type<T>::type;
+#else
+    template <class T>
+    using pairwise_vector = T;
+#endif
+
+    /* Elements are read in order from a source, one at a time through
+     * scalar(), or pairwise_lanes<vector_type>::size at a time through
+     * next().
+     */
+    template <class T, class E>
+    struct pairwise_indexed {
+      using vector_type = T;
+      E const *e;
+      long i;
+      T next()
+      {
+        return e->fast(i++);
+      }
+      T scalar()
+      {
+        return e->fast(i++);
+      }
+    };
+
+    template <class T>
+    struct pairwise_contiguous {
+      using vector_type = pairwise_vector<T>;
+      T const *data;
+      vector_type next()
+      {
+        using lanes = pairwise_lanes<vector_type>;
+        vector_type value = lanes::load(data);
+        data += lanes::size;
+        return value;
+      }
+      T scalar()
+      {
+        return *data++;
+      }
+    };
+
+#ifdef USE_XSIMD
+    /* Vectorized expressions are read through their vector iterator, and
+     * their trailing elements through a scalar iterator. Vectors larger
+     * than the accumulators are split.
+     */
+    template <class T, class E, bool split = (xsimd::simd_traits<T>::size >
+                                              pairwise_accumulators)>
+    struct pairwise_vectorized;
+
+    template <class T, class E>
+    struct pairwise_vectorized<T, E, false> {
+      using vector_type = xsimd::simd_type<T>;
+      decltype(types::vectorizer_nobroadcast::vbegin(
+          std::declval<E const &>())) viter;
+      decltype(std::declval<E const &>().begin()) iter;
+      // only the last block has trailing elements
+      pairwise_vectorized(E const &e, long n)
+          : viter(types::vectorizer_nobroadcast::vbegin(e)),
+            iter(e.begin() + (n - n % pairwise_accumulators))
+      {
+      }
+      vector_type next()
+      {
+        vector_type value = *viter;
+        ++viter;
+        return value;
+      }
+      T scalar()
+      {
+        T value = *iter;
+        ++iter;
+        return value;
+      }
+    };
+
+    template <class T, class E>
+    struct pairwise_vectorized<T, E, true> {
+      using vector_type = pairwise_vector<T>;
+      using lanes = pairwise_lanes<vector_type>;
+      static const long vN = xsimd::simd_type<T>::size;
+      decltype(types::vectorizer_nobroadcast::vbegin(
+          std::declval<E const &>())) viter;
+      decltype(std::declval<E const &>().begin()) iter;
+      long vectors, pos = vN;
+      alignas(sizeof(xsimd::simd_type<T>)) T buffer[vN];
+      pairwise_vectorized(E const &e, long n)
+          : viter(types::vectorizer_nobroadcast::vbegin(e)),
+            iter(e.begin() + (n - n % vN)), vectors(n / vN)
+      {
+      }
+      vector_type next()
+      {
+        if (pos == vN) {
+          if (!vectors) {
+            for (long j = vN - lanes::size; j < vN; ++j)
+              buffer[j] = scalar();
+            return lanes::load(buffer + vN - lanes::size);
+          }
+          (*viter).store_aligned(buffer);
+          ++viter;
+          --vectors;
+          pos = 0;
+        }
+        vector_type value = lanes::load(buffer + pos);
+        pos += lanes::size;
+        return value;
+      }
+      T scalar()
+      {
+        T value = *iter;
+        ++iter;
+        return value;
+      }
+    };
+#endif
+
+    template <class T, class Source>
+    pairwise_result<T> pairwise_leaf(Source &src, long n)
+    {
+      using V = typename Source::vector_type;
+      using lanes = pairwise_lanes<V>;
+      static const long vN = lanes::size, nv = pairwise_accumulators / vN;
+      // a local copy of the source is easier to keep in registers
+      Source s = src;
+      long i = pairwise_accumulators, nb = n - n % pairwise_accumulators;
+      T r[pairwise_accumulators];
+      V vr[nv];
+      for (long j = 0; j < nv; ++j)
+        vr[j] = s.next();
+#ifdef PYTHRAN_KAHAN_SUMMATION
+      V vc[nv];
+      for (long j = 0; j < nv; ++j)
+        vc[j] = V(T(0));
+      for (; i < nb; i += pairwise_accumulators)
+        for (long j = 0; j < nv; ++j) {
+          V y = s.next() - vc[j];
+          V t = vr[j] + y;
+          vc[j] = (t - vr[j]) - y;
+          vr[j] = t;
+        }
+      T c[pairwise_accumulators];
+      for (long j = 0; j < nv; ++j) {
+        lanes::store(vr[j], &r[j * vN]);
+        lanes::store(vc[j], &c[j * vN]);
+      }
+      pairwise_result<T> res;
+      for (long j = 0; j < pairwise_accumulators; ++j)
+        res += r[j];
+      for (long j = 0; j < pairwise_accumulators; ++j)
+        res += -c[j];
+#else
+      for (; i < nb; i += pairwise_accumulators)
+        for (long j = 0; j < nv; ++j)
+          vr[j] += s.next();
+      for (long j = 0; j < nv; ++j)
+        lanes::store(vr[j], &r[j * vN]);
+      T res = ((r[0] + r[1]) + (r[2] + r[3])) + ((r[4] + r[5]) + (r[6] + r[7]));
+#endif
+      for (; i < n; ++i)
+        res += s.scalar();
+      src = s;
+      return res;
+    }
+
+    template <class T, class Source>
+    pairwise_result<T> pairwise_tree(Source &src, long n)
+    {
+      if (n < pairwise_accumulators) {
+        pairwise_result<T> res{};
+        for (long i = 0; i < n; ++i)
+          res += src.scalar();
+        return res;
+      } else if (n <= pairwise_block) {
+        return pairwise_leaf<T>(src, n);
+      } else {
+        long n2 = n / 2;
+        n2 -= n2 % pairwise_accumulators;
+        pairwise_result<T> left = pairwise_tree<T>(src, n2);
+        return left + pairwise_tree<T>(src, n - n2);
+      }
+    }
+
+    template <class T>
+    T pairwise_sum(T const *data, long n)
+    {
+      pairwise_contiguous<T> src{data};
+      return pairwise_tree<T>(src, n);
+    }
+
+    template <class T, class E>
+    T pairwise_sum(E const &e, std::false_type)
+    {
+      pairwise_indexed<T, E> src{&e, 0};
+      return pairwise_tree<T>(src, std::get<0>(e.shape()));
+    }
+
+#ifdef USE_XSIMD
+    template <class T, class E>
+    T pairwise_sum(E const &e, std::true_type)
+    {
+      long n = e.size();
+      pairwise_vectorized<T, E> src(e, n);
+      return pairwise_tree<T>(src, n);
+    }
+
+    template <class T, class E>
+    T pairwise_sum(E const &e)
+    {
+      return pairwise_sum<T>(
+          e, std::integral_constant<
+                 bool, E::is_vectorizable &&
+                           std::is_same<T, typename E::dtype>::value>{});
+    }
+#else
+    template <class T, class E>
+    T pairwise_sum(E const &e)
+    {
+      return pairwise_sum<T>(e, std::false_type{});
+    }
+#endif
+
+    // one dimensional views on contiguous memory
+    template <class T, class E, class Enable = void>
+    struct is_pairwise_contiguous : std::false_type {
+    };
+
+    template <class T, class E>
+    struct is_pairwise_contiguous<
+        T, E, typename std::enable_if<std::is_convertible<
+                  decltype(std::declval<E const &>().buffer),
+                  T const *>::value>::type>
+        : std::integral_constant<
+              bool, E::value == 1 && !E::is_strided &&
+                        std::is_same<T, typename E::dtype>::value> {
+    };
+
+    // contiguous arrays are summed as a whole, as numpy does
+    template <class T, class pS>
+    T pairwise_reduce(types::ndarray<T, pS> const &e)
+    {
+      return pairwise_sum(e.buffer, e.flat_size());
+    }
+
+    template <class T, class pS>
+    T pairwise_reduce(types::numpy_texpr<types::ndarray<T, pS>> const &e)
+    {
+      return pairwise_sum(e.arg.buffer, e.arg.flat_size());
+    }
+
+    template <class T, class E>
+    typename std::enable_if<is_pairwise_contiguous<T, E>::value, T>::type
+    pairwise_reduce(E const &e, utils::int_<1>)
+    {
+      return pairwise_sum((T const *)e.buffer, e.flat_size());
+    }
+
+    template <class T, class E>
+    typename std::enable_if<!is_pairwise_contiguous<T, E>::value, T>::type
+    pairwise_reduce(E const &e, utils::int_<1>)
+    {
+      return pairwise_sum<T>(e);
+    }
+
+    template <class T, class E, size_t N>
+    T pairwise_reduce(E const &e, utils::int_<N>)
+    {
+      T res = 0;
+      for (long i = 0, n = std::get<0>(e.shape()); i < n; ++i)
+        res += pairwise_reduce<T>(e.fast(i), utils::int_<N - 1>());
+      return res;
+    }
+
+    template <class T, class E>
+    T pairwise_reduce(E const &e)
+    {
+      return pairwise_reduce<T>(e, utils::int_<E::value>());
+    }
+  }
+
+  // floating point sums are computed pairwise, whenever elements can be
+  // accessed randomly, that is without broadcasting
   template <class Op, class E>
-  typename std::enable_if<types::is_numexpr_arg<E>::value,
-                          reduce_result_type<Op, E>>::type
-  reduce(E const &expr, types::none_type)
+  using is_pairwise_sum = std::integral_constant<
+      bool, std::is_same<Op, operator_::functor::iadd>::value &&
+                std::is_floating_point<reduce_result_type<Op, E>>::value>;
+
+  template <class Op, class E>
+  reduce_result_type<Op, E> _reduce_seq(E const &expr, std::false_type)
   {
     bool constexpr is_vectorizable =
         E::is_vectorizable && !std::is_same<typename E::dtype, bool>::value;
@@ -160,6 +542,111 @@ namespace numpy
     return reduce_helper<Op, E, is_vectorizable>{}(expr, p);
   }
 
+  template <class Op, class E>
+  reduce_result_type<Op, E> _reduce_seq(E const &expr, std::true_type)
+  {
+    if (utils::no_broadcast(expr))
+      return details::pairwise_reduce<reduce_result_type<Op, E>>(expr);
+    else
+      return _reduce_seq<Op>(expr, std::false_type{});
+  }
+
+  template <class Op, class E>
+  reduce_result_type<Op, E> _reduce_seq(E const &expr)
+  {
+    return _reduce_seq<Op>(expr, is_pairwise_sum<Op, E>{});
+  }
+
+#ifdef _OPENMP
+  template <class Op, class E>
+  reduce_result_type<Op, E> _reduce_rows(E const &expr, utils::int_<1>)
+  {
+    return _reduce_seq<Op>(expr);
+  }
+
+  template <class Op, class E, size_t N>
+  reduce_result_type<Op, E> _reduce_rows(E const &expr, utils::int_<N>)
+  {
+    reduce_result_type<Op, E> p = utils::neutral<Op, typename E::dtype>::value;
+    for (long i = 0, n = std::get<0>(expr.shape()); i < n; ++i)
+      Op{}(p, reduce<Op>(expr.fast(i)));
+    return p;
+  }
+
+  template <class Op, class E>
+  typename std::enable_if<!utils::is_splittable<E>::value,
+                          reduce_result_type<Op, E>>::type
+  _reduce_par(E const &expr)
+  {
+    return _reduce_seq<Op>(expr);
+  }
+
+  template <class Op, class E>
+  typename std::enable_if<utils::is_splittable<E>::value,
+                          reduce_result_type<Op, E>>::type
+  _reduce_par(E const &expr)
+  {
+    using T = reduce_result_type<Op, E>;
+    long n = expr.flat_size();
+    if (n < 2 * PYTHRAN_OPENMP_REDUCTION_BLOCK || !utils::no_broadcast(expr))
+      return _reduce_seq<Op>(expr);
+    long size = std::get<0>(expr.shape());
+    long row_size = n / size;
+    // large rows are reduced one after the other, each one in parallel
+    if (row_size >= PYTHRAN_OPENMP_REDUCTION_BLOCK)
+      return _reduce_rows<Op>(expr, utils::int_<E::value>());
+    // otherwise each thread reduces blocks of rows with its own, possibly
+    // vectorized, accumulator
+    return utils::parallel_reduce<T>(
+        size, std::max(1L, PYTHRAN_OPENMP_REDUCTION_BLOCK / row_size),
+        [&expr](long lo, long hi) {
+          return _reduce_seq<Op>(expr[types::contiguous_slice(lo, hi)]);
+        },
+        [](T &self, T const &other) { Op{}(self, other); });
+  }
+
+  template <class Op, class E, class Out>
+  bool _reduce_axis_par(E const &array, long axis, Out &&out)
+  {
+    if (array.flat_size() < 2 * PYTHRAN_OPENMP_REDUCTION_BLOCK ||
+        !utils::no_broadcast(array))
+      return false;
+    if (axis == 0) {
+      // columns are spread among threads and accumulate the rows in order,
+      // as the sequential version does
+      long n = std::get<0>(array.shape()), m = std::get<1>(array.shape());
+      long const width = 256;
+#pragma omp parallel for
+      for (long lo = 0; lo < m; lo += width) {
+        long hi = std::min(m, lo + width);
+        for (long i = 0; i < n; ++i) {
+          auto row = array.fast(i);
+          for (long j = lo; j < hi; ++j)
+            Op{}(out.fast(j), row.fast(j));
+        }
+      }
+    } else {
+      long n = std::get<0>(array.shape());
+#pragma omp parallel for
+      for (long i = 0; i < n; ++i)
+        reduce<Op>(array.fast(i), axis - 1, types::none_type{}, out.fast(i));
+    }
+    return true;
+  }
+#endif
+
+  template <class Op, class E>
+  typename std::enable_if<types::is_numexpr_arg<E>::value,
+                          reduce_result_type<Op, E>>::type
+  reduce(E const &expr, types::none_type)
+  {
+#ifdef _OPENMP
+    return _reduce_par<Op>(expr);
+#else
+    return _reduce_seq<Op>(expr);
+#endif
+  }
+
   template <class Op, class E>
   typename std::enable_if<
       std::is_scalar<E>::value || types::is_complex<E>::value, E>::type
@@ -209,15 +696,24 @@ namespace numpy
       types::array<long, E::value - 1> shp;
       sutils::copy_shape<0, 1>(shp, shape,
                                utils::make_index_sequence<E::value - 1>());
-      return _reduce<Op, 1, types::novectorize /* ! on scalars*/>{}(
-          array, reduced_type<E, Op>{
-                     shp, utils::neutral<Op, typename E::dtype>::value});
+      reduced_type<E, Op> out{shp,
+                              utils::neutral<Op, typename E::dtype>::value};
+#ifdef _OPENMP
+      if (_reduce_axis_par<Op>(array, axis, out))
+        return out;
+#endif
+      return _reduce<Op, 1, types::novectorize /* ! on scalars*/>{}(array,
+                                                                     out);
     } else {
       types::array<long, E::value - 1> shp;
       auto tmp = sutils::array(shape);
       auto next = std::copy(tmp.begin(), tmp.begin() + axis, shp.begin());
       std::copy(tmp.begin() + axis + 1, tmp.end(), next);
       reduced_type<E, Op> sumy{shp, __builtin__::None};
+#ifdef _OPENMP
+      if (_reduce_axis_par<Op>(array, axis, sumy))
+        return sumy;
+#endif
 
       auto sumy_iter = sumy.begin();
       for (auto const &elem : array) {
@@ -238,9 +734,17 @@ namespace numpy
     if (axis == 0) {
       std::fill(out.begin(), out.end(),
                 utils::neutral<Op, typename E::dtype>::value);
+#ifdef _OPENMP
+      if (_reduce_axis_par<Op>(array, axis, out))
+        return std::forward<Out>(out);
+#endif
       return _reduce<Op, 1, types::novectorize /* ! on scalars*/>{}(
           array, std::forward<Out>(out));
     } else {
+#ifdef _OPENMP
+      if (_reduce_axis_par<Op>(array, axis, out))
+        return std::forward<Out>(out);
+#endif
       std::transform(array.begin(), array.end(), out.begin(),
                      [axis](typename E::const_iterator::value_type other) {
                        return reduce<Op>(other, axis - 1);
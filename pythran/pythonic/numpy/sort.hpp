@@ -4,105 +4,171 @@
 #include "pythonic/include/numpy/sort.hpp"
 
 #include <algorithm>
+#include <memory>
+#include <numeric>
 
 #include "pythonic/utils/functor.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/str.hpp"
+#include "pythonic/utils/sort.hpp"
 
 PYTHONIC_NS_BEGIN
 namespace numpy
 {
   namespace
   {
+    template <class T>
+    using _comp = utils::sort_less<T>;
+
+    template <class T>
+    using _radix_sortable =
+        std::integral_constant<bool, utils::radix_key<T>::value>;
+
+    template <class T, class Sorter>
+    void _radix_sort_or(T *first, T *last, Sorter const &, std::true_type)
+    {
+      utils::radix_sort(first, last);
+    }
+
+    template <class T, class Sorter>
+    void _radix_sort_or(T *first, T *last, Sorter const &sorter,
+                        std::false_type)
+    {
+      sorter.sort(first, last);
+    }
+
     struct quicksorter {
-      template <class... Args>
-      void operator()(Args &&... args)
+      template <class T>
+      void sort(T *first, T *last) const
       {
-        std::sort(std::forward<Args>(args)...);
+        std::sort(first, last, _comp<T>{});
+      }
+      template <class T>
+      void operator()(T *first, T *last) const
+      {
+        long n = last - first;
+        if (n <= PYTHRAN_SHORT_SORT_SIZE)
+          utils::insertion_sort(first, last);
+        else if (n >= PYTHRAN_RADIX_SORT_THRESHOLD)
+          _radix_sort_or(first, last, *this, _radix_sortable<T>{});
+        else
+          sort(first, last);
       }
     };
     struct mergesorter {
-      template <class It, class Cmp = std::less<typename It::value_type>>
-      void operator()(It first, It last, Cmp cmp = Cmp())
+      template <class T>
+      void sort(T *first, T *last) const
       {
         if (last - first > 1) {
-          It middle = first + (last - first) / 2;
-          operator()(first, middle, cmp);
-          operator()(middle, last, cmp);
-          std::inplace_merge(first, middle, last, cmp);
+          T *middle = first + (last - first) / 2;
+          sort(first, middle);
+          sort(middle, last);
+          std::inplace_merge(first, middle, last, _comp<T>{});
         }
       }
+      template <class T>
+      void operator()(T *first, T *last) const
+      {
+        if (last - first <= PYTHRAN_SHORT_SORT_SIZE)
+          utils::insertion_sort(first, last);
+        else
+          _radix_sort_or(first, last, *this, _radix_sortable<T>{});
+      }
     };
     struct heapsorter {
-      template <class... Args>
-      void operator()(Args &&... args)
+      template <class T>
+      void operator()(T *first, T *last) const
       {
-        return std::sort_heap(std::forward<Args>(args)...);
+        std::make_heap(first, last, _comp<T>{});
+        std::sort_heap(first, last, _comp<T>{});
       }
     };
     struct stablesorter {
-      template <class... Args>
-      void operator()(Args &&... args)
+      template <class T>
+      void sort(T *first, T *last) const
       {
-        return std::stable_sort(std::forward<Args>(args)...);
+        std::stable_sort(first, last, _comp<T>{});
       }
-    };
-
-    template <class T>
-    struct _comp {
-      bool operator()(T const &i, T const &j) const
+      template <class T>
+      void operator()(T *first, T *last) const
       {
-        return i < j;
+        if (last - first <= PYTHRAN_SHORT_SORT_SIZE)
+          utils::insertion_sort(first, last);
+        else
+          _radix_sort_or(first, last, *this, _radix_sortable<T>{});
       }
     };
 
-    template <class T>
-    struct _comp<std::complex<T>> {
-      bool operator()(std::complex<T> const &i, std::complex<T> const &j) const
+    template <class Sorter>
+    struct _lane_sorter {
+      Sorter sorter;
+      template <class T>
+      void operator()(T *lane, long n) const
       {
-        if (std::real(i) == std::real(j))
-          return std::imag(i) < std::imag(j);
-        else
-          return std::real(i) < std::real(j);
+        sorter(lane, lane + n);
       }
     };
-    template <class T, class pS, class Sorter>
-    typename std::enable_if<std::tuple_size<pS>::value == 1, void>::type
-    _sort(types::ndarray<T, pS> &out, long axis, Sorter sorter)
+
+    template <class T, class Sorter>
+    void _sort_lanes(T *data, long outer, long n, long inner,
+                     Sorter const &sorter)
     {
-      sorter(out.begin(), out.end(), _comp<T>{});
+      utils::sort_lanes(data, outer, n, inner, _lane_sorter<Sorter>{sorter});
+    }
+
+    /* Short lanes go through the vectorized sorting network, each vector
+     * holding elements of different lanes: rows are transposed by tiles,
+     * other lanes are already interleaved.
+     */
+    template <class T>
+    void _sort_lanes(T *data, long outer, long n, long inner,
+                     quicksorter const &sorter)
+    {
+      constexpr long width = PYTHRAN_SORT_TILE;
+      if (!utils::network_vectorized<T>::value ||
+          n > PYTHRAN_SHORT_SORT_SIZE)
+        return utils::sort_lanes(data, outer, n, inner,
+                                 _lane_sorter<quicksorter>{sorter});
+      long const size = outer * n * inner;
+      if (inner == 1) {
+        long const tiles = outer / width;
+#pragma omp parallel for if (utils::parallel_lanes(size, tiles))
+        for (long t = 0; t < tiles; ++t) {
+          T tile[PYTHRAN_SHORT_SORT_SIZE * width];
+          T *rows = data + t * width * n;
+          utils::scatter_tile(tile, rows, n, width, width);
+          utils::network_sort(tile, n, width, width);
+          utils::gather_tile(rows, tile, n, width, width);
+        }
+        for (long r = tiles * width; r < outer; ++r)
+          sorter(data + r * n, data + (r + 1) * n);
+      } else {
+        long const tiles = (inner + width - 1) / width;
+#pragma omp parallel for if (utils::parallel_lanes(size, outer * tiles))
+        for (long t = 0; t < outer * tiles; ++t) {
+          long const i = t % tiles * width;
+          utils::network_sort(data + t / tiles * n * inner + i, n,
+                              std::min(width, inner - i), inner);
+        }
+      }
     }
 
     template <class T, class pS, class Sorter>
-    typename std::enable_if<std::tuple_size<pS>::value != 1, void>::type
-    _sort(types::ndarray<T, pS> &out, long axis, Sorter sorter)
+    void _sort(types::ndarray<T, pS> &out, long axis, Sorter const &sorter)
     {
-      constexpr auto N = std::tuple_size<pS>::value;
+      constexpr long N = std::tuple_size<pS>::value;
       if (axis < 0)
         axis += N;
-
       axis = axis % N;
       auto out_shape = sutils::array(out.shape());
-      const long step =
-          std::accumulate(out_shape.begin() + axis, out_shape.end(), 1L,
+      long const n = out_shape[axis];
+      if (out.flat_size() == 0)
+        return;
+      long const inner =
+          std::accumulate(out_shape.begin() + axis + 1, out_shape.end(), 1L,
                           std::multiplies<long>());
-      for (long i = 0; i < out.flat_size() / out_shape[axis] * step;
-           i += step) {
-        std::vector<T> to_sort;
-        T *iter = out.buffer + (i % out.flat_size() + i / out.flat_size());
-        while (iter !=
-               out.buffer + (i % out.flat_size() + i / out.flat_size()) +
-                   step) {
-          to_sort.push_back(*iter);
-          iter += step / out_shape[axis];
-        }
-        sorter(to_sort.begin(), to_sort.end(), _comp<T>{});
-        iter = out.buffer + (i % out.flat_size() + i / out.flat_size());
-        for (auto val : to_sort) {
-          *iter = val;
-          iter += step / out_shape[axis];
-        }
-      }
+      _sort_lanes(out.buffer, out.flat_size() / (n * inner), n, inner,
+                  sorter);
     }
   }
 
@@ -6,9 +6,10 @@
 #include "pythonic/utils/functor.hpp"
 #include "pythonic/types/ndarray.hpp"
 #include "pythonic/types/tuple.hpp"
+#include "pythonic/numpy/sort.hpp"
 
-#include <set>
-#include <map>
+#include <algorithm>
+#include <vector>
 
 PYTHONIC_NS_BEGIN
 
@@ -16,84 +17,132 @@ namespace numpy
 {
   namespace
   {
-    template <class I, class O>
-    void _unique1(I begin, I end, O &out, utils::int_<1>)
+    /* Flat traversal of an expression, feeding each element to a sink.
+     * Used to copy the input once into a contiguous buffer, from which
+     * everything is computed through a sort and a run-length pass.
+     */
+    template <class I, class F>
+    void _unique_visit(I begin, I end, F &f, utils::int_<1>)
     {
-      out.insert(begin, end);
+      for (; begin != end; ++begin)
+        f(*begin);
     }
 
-    template <class I, class O, size_t N>
-    void _unique1(I begin, I end, O &out, utils::int_<N>)
+    template <class I, class F, size_t N>
+    void _unique_visit(I begin, I end, F &f, utils::int_<N>)
     {
       for (; begin != end; ++begin)
-        _unique1((*begin).begin(), (*begin).end(), out, utils::int_<N - 1>());
+        _unique_visit((*begin).begin(), (*begin).end(), f,
+                      utils::int_<N - 1>());
     }
 
-    template <class I, class O0, class O1>
-    void _unique2(I begin, I end, O0 &out0, O1 &out1, long &i, utils::int_<1>)
-    {
-      for (; begin != end; ++begin, ++i) {
-        auto pair = out0.insert(*begin);
-        if (pair.second)
-          out1.push_back(i);
+    template <class T>
+    struct _unique_value_sink {
+      std::vector<T> &values;
+      void operator()(T const &value)
+      {
+        values.push_back(value);
       }
-    }
+    };
+
+    template <class T>
+    struct _unique_pair_sink {
+      std::vector<std::pair<T, long>> &pairs;
+      void operator()(T const &value)
+      {
+        pairs.emplace_back(value, (long)pairs.size());
+      }
+    };
 
-    template <class I, class O0, class O1, size_t N>
-    void _unique2(I begin, I end, O0 &out0, O1 &out1, long &i, utils::int_<N>)
-    {
-      for (; begin != end; ++begin)
-        _unique2((*begin).begin(), (*begin).end(), out0, out1, i,
-                 utils::int_<N - 1>());
-    }
-    template <class I, class O0, class O1, class O2>
-    void _unique3(I begin, I end, O0 &out0, O1 &out1, O2 &out2, long &i,
-                  utils::int_<1>)
-    {
-      for (; begin != end; ++begin, ++i) {
-        auto pair = out0.insert(*begin);
-        out2[i] = std::distance(out0.begin(), pair.first);
-        if (pair.second)
-          out1.push_back(i);
+    template <class T>
+    struct _unique_equal {
+      bool operator()(T const &i, T const &j) const
+      {
+        return !_comp<T>{}(i, j) && !_comp<T>{}(j, i);
       }
+    };
+
+    // Orders by value, then by position, so that the first element of each
+    // run of equal values is its first occurrence in the input.
+    template <class T>
+    struct _unique_pair_comp {
+      bool operator()(std::pair<T, long> const &i,
+                      std::pair<T, long> const &j) const
+      {
+        if (_comp<T>{}(i.first, j.first))
+          return true;
+        if (_comp<T>{}(j.first, i.first))
+          return false;
+        return i.second < j.second;
+      }
+    };
+
+    template <class E>
+    std::vector<std::pair<typename E::dtype, long>>
+    _unique_sorted_pairs(E const &expr)
+    {
+      using T = typename E::dtype;
+      std::vector<std::pair<T, long>> pairs;
+      pairs.reserve(expr.flat_size());
+      _unique_pair_sink<T> sink{pairs};
+      _unique_visit(expr.begin(), expr.end(), sink, utils::int_<E::value>());
+      std::sort(pairs.begin(), pairs.end(), _unique_pair_comp<T>{});
+      return pairs;
     }
-    template <class I, class O0, class O1, class O2, size_t N>
-    void _unique3(I begin, I end, O0 &out0, O1 &out1, O2 &out2, long &i,
-                  utils::int_<N>)
+
+    template <class T>
+    long _unique_count_runs(std::vector<std::pair<T, long>> const &pairs)
     {
-      for (; begin != end; ++begin)
-        _unique3((*begin).begin(), (*begin).end(), out0, out1, out2, i,
-                 utils::int_<N - 1>());
+      if (pairs.empty())
+        return 0;
+      long count = 1;
+      _unique_equal<T> eq;
+      for (size_t i = 1; i < pairs.size(); ++i)
+        count += !eq(pairs[i - 1].first, pairs[i].first);
+      return count;
     }
 
-    template <class I, class O1, class O2, class O3>
-    void _unique4(I begin, I end, O1 &out1, O2 &out2, O3 &out3, long &i,
-                  utils::int_<1>)
+    /* Single run-length pass over the sorted (value, position) pairs.
+     * Optional outputs are skipped when their pointer is null.
+     */
+    template <class T>
+    void _unique_runs(std::vector<std::pair<T, long>> const &pairs,
+                      T *unique_out, long *index_out, long *inverse_out,
+                      long *counts_out)
     {
-      for (; begin != end; ++begin, ++i) {
-        auto res = out3.insert(std::make_pair(*begin, 0));
-        res.first->second += 1;
-        out2[i] = std::distance(out3.begin(), res.first);
-        if (res.second) {
-          out1.push_back(i);
+      _unique_equal<T> eq;
+      long run = -1;
+      long run_start = 0;
+      for (size_t i = 0; i < pairs.size(); ++i) {
+        if (run < 0 || !eq(pairs[i - 1].first, pairs[i].first)) {
+          if (counts_out && run >= 0)
+            counts_out[run] = i - run_start;
+          ++run;
+          run_start = i;
+          unique_out[run] = pairs[i].first;
+          if (index_out)
+            index_out[run] = pairs[i].second;
         }
+        if (inverse_out)
+          inverse_out[pairs[i].second] = run;
       }
-    }
-    template <class I, class O1, class O2, class O3, size_t N>
-    void _unique4(I begin, I end, O1 &out1, O2 &out2, O3 &out3, long &i,
-                  utils::int_<N>)
-    {
-      for (; begin != end; ++begin)
-        _unique4((*begin).begin(), (*begin).end(), out1, out2, out3, i,
-                 utils::int_<N - 1>());
+      if (counts_out && run >= 0)
+        counts_out[run] = pairs.size() - run_start;
     }
   }
+
   template <class E>
   types::ndarray<typename E::dtype, types::pshape<long>> unique(E const &expr)
   {
-    std::set<typename E::dtype> res;
-    _unique1(expr.begin(), expr.end(), res, utils::int_<E::value>());
-    return {res};
+    using T = typename E::dtype;
+    std::vector<T> values;
+    values.reserve(expr.flat_size());
+    _unique_value_sink<T> sink{values};
+    _unique_visit(expr.begin(), expr.end(), sink, utils::int_<E::value>());
+    std::sort(values.begin(), values.end(), _comp<T>{});
+    values.erase(std::unique(values.begin(), values.end(), _unique_equal<T>{}),
+                 values.end());
+    return {values};
   }
 
   template <class E>
@@ -101,14 +150,16 @@ namespace numpy
              types::ndarray<long, types::pshape<long>>>
   unique(E const &expr, bool return_index)
   {
-    std::set<typename E::dtype> res;
-    std::vector<long> return_index_res;
-    long i = 0;
-    _unique2(expr.begin(), expr.end(), res, return_index_res, i,
-             utils::int_<E::value>());
-    return std::make_tuple(
-        types::ndarray<typename E::dtype, types::pshape<long>>(res),
-        types::ndarray<long, types::pshape<long>>(return_index_res));
+    using T = typename E::dtype;
+    auto pairs = _unique_sorted_pairs(expr);
+    types::pshape<long> shp{_unique_count_runs(pairs)};
+
+    types::ndarray<T, types::pshape<long>> unique_array(shp, __builtin__::None);
+    types::ndarray<long, types::pshape<long>> return_index_res(
+        shp, __builtin__::None);
+    _unique_runs(pairs, unique_array.buffer, return_index_res.buffer, nullptr,
+                 nullptr);
+    return std::make_tuple(unique_array, return_index_res);
   }
 
   template <class E>
@@ -119,17 +170,18 @@ namespace numpy
   {
     assert(return_inverse && "invalid signature otherwise");
 
-    std::set<typename E::dtype> res;
-    std::vector<long> return_index_res;
+    using T = typename E::dtype;
+    auto pairs = _unique_sorted_pairs(expr);
+    types::pshape<long> shp{_unique_count_runs(pairs)};
+
+    types::ndarray<T, types::pshape<long>> unique_array(shp, __builtin__::None);
+    types::ndarray<long, types::pshape<long>> return_index_res(
+        shp, __builtin__::None);
     types::ndarray<long, types::pshape<long>> return_inverse_res(
-        types::pshape<long>{expr.flat_size()}, __builtin__::None);
-    long i = 0;
-    _unique3(expr.begin(), expr.end(), res, return_index_res,
-             return_inverse_res, i, utils::int_<E::value>());
-    return std::make_tuple(
-        types::ndarray<typename E::dtype, types::pshape<long>>(res),
-        types::ndarray<long, types::pshape<long>>(return_index_res),
-        return_inverse_res);
+        types::pshape<long>{(long)pairs.size()}, __builtin__::None);
+    _unique_runs(pairs, unique_array.buffer, return_index_res.buffer,
+                 return_inverse_res.buffer, nullptr);
+    return std::make_tuple(unique_array, return_index_res, return_inverse_res);
   }
 
   template <class E>
@@ -142,37 +194,22 @@ namespace numpy
   {
     assert(return_counts && "invalid signature otherwise");
 
-    std::vector<long> return_index_res;
-    types::ndarray<long, types::pshape<long>> return_inverse_res(
-        types::pshape<long>{expr.flat_size()}, __builtin__::None);
-
-    std::map<typename E::dtype, long> return_counts_map;
-    {
-      long i = 0;
-      _unique4(expr.begin(), expr.end(), return_index_res, return_inverse_res,
-               return_counts_map, i, utils::int_<E::value>());
-    }
-
-    types::pshape<long> shp{(long)return_counts_map.size()};
+    using T = typename E::dtype;
+    auto pairs = _unique_sorted_pairs(expr);
+    types::pshape<long> shp{_unique_count_runs(pairs)};
 
-    types::ndarray<long, types::pshape<long>> unique_array(shp,
-                                                           __builtin__::None);
+    types::ndarray<T, types::pshape<long>> unique_array(shp, __builtin__::None);
+    types::ndarray<long, types::pshape<long>> return_index_res(
+        shp, __builtin__::None);
+    types::ndarray<long, types::pshape<long>> return_inverse_res(
+        types::pshape<long>{(long)pairs.size()}, __builtin__::None);
     types::ndarray<long, types::pshape<long>> return_counts_array(
         shp, __builtin__::None);
+    _unique_runs(pairs, unique_array.buffer, return_index_res.buffer,
+                 return_inverse_res.buffer, return_counts_array.buffer);
 
-    {
-      long i = 0;
-      for (auto it = return_counts_map.begin(); it != return_counts_map.end();
-           ++i, ++it) {
-        unique_array.fast(i) = it->first;
-        return_counts_array.fast(i) = it->second;
-      }
-    }
-
-    return std::make_tuple(
-        unique_array,
-        types::ndarray<long, types::pshape<long>>(return_index_res),
-        return_inverse_res, return_counts_array);
+    return std::make_tuple(unique_array, return_index_res, return_inverse_res,
+                           return_counts_array);
   }
 }
 PYTHONIC_NS_END
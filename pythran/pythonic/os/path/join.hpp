@@ -39,11 +39,11 @@ namespace os
       {
         if (((types::str)head)[0] == "/")
           buffer = std::forward<T>(head);
-        else if (!buffer || *buffer.chars().rbegin() == OS_SEP ||
+        else if (!buffer || buffer.raw()[buffer.size() - 1] == OS_SEP ||
                  *buffer.rbegin() == "/")
           buffer += std::forward<T>(head);
         else {
-          buffer.chars() += OS_SEP;
+          buffer += types::str(OS_SEP);
           buffer += std::forward<T>(head);
         }
         _join(buffer, std::forward<Types>(tail)...);
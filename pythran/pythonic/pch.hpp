@@ -0,0 +1,28 @@
+#ifndef PYTHONIC_PCH_HPP
+#define PYTHONIC_PCH_HPP
+
+/* Headers included by almost every generated module. When the compiler.pch
+ * option is set, they are parsed once into a precompiled header, shared by all
+ * the modules built with the same compiler && flags.
+ */
+
+#include "pythonic/core.hpp"
+#include "pythonic/python/core.hpp"
+
+#include "pythonic/types/bool.hpp"
+#include "pythonic/types/int.hpp"
+#include "pythonic/types/float.hpp"
+#include "pythonic/types/complex.hpp"
+#include "pythonic/types/NoneType.hpp"
+#include "pythonic/types/str.hpp"
+#include "pythonic/types/list.hpp"
+#include "pythonic/types/set.hpp"
+#include "pythonic/types/dict.hpp"
+#include "pythonic/types/tuple.hpp"
+#include "pythonic/types/ndarray.hpp"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#endif
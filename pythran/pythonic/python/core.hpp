@@ -7,6 +7,7 @@
 // Python defines this for windows, and it's not needed in C++
 #undef copysign
 
+#include <algorithm>
 #include <type_traits>
 #include <utility>
 #include <sstream>
@@ -18,6 +19,11 @@
 #endif
 #include "numpy/arrayobject.h"
 
+// METH_FASTCALL entry points are part of the stable API since Python 3.7
+#if PY_VERSION_HEX >= 0x03070000 && !defined(PYTHRAN_NO_FASTCALL)
+#define PYTHRAN_FASTCALL
+#endif
+
 PYTHONIC_NS_BEGIN
 template <class T>
 struct to_python;
@@ -168,6 +174,59 @@ namespace python
     PyErr_SetString(PyExc_TypeError, oss.str().c_str());
     return nullptr;
   }
+
+#ifdef PYTHRAN_FASTCALL
+  // Sorts the arguments of a METH_FASTCALL call by parameter position in
+  // `args_obj`, which holds one slot per keyword. Returns the number of
+  // arguments, or -1 if a keyword is unknown, duplicated or leaves a hole.
+  long fastcall_arguments(PyObject *args_obj[], char const *const keywords[],
+                          long size, PyObject *const *args, Py_ssize_t nargs,
+                          PyObject *kwnames)
+  {
+    if (nargs > size)
+      return -1;
+    std::copy(args, args + nargs, args_obj);
+    std::fill(args_obj + nargs, args_obj + size, nullptr);
+    long count = nargs;
+    for (Py_ssize_t k = 0, n = kwnames ? PyTuple_GET_SIZE(kwnames) : 0; k < n;
+         ++k) {
+      PyObject *kwname = PyTuple_GET_ITEM(kwnames, k);
+      long i = nargs;
+      while (i < size && PyUnicode_CompareWithASCIIString(kwname, keywords[i]))
+        ++i;
+      if (i == size || args_obj[i])
+        return -1;
+      args_obj[i] = args[nargs + k];
+      count = std::max(count, i + 1);
+    }
+    for (long i = nargs; i < count; ++i)
+      if (!args_obj[i])
+        return -1;
+    return count;
+  }
+
+  std::nullptr_t raise_invalid_argument(char const name[],
+                                        char const alternatives[],
+                                        PyObject *const *args,
+                                        Py_ssize_t nargs, PyObject *kwnames)
+  {
+    PyObject *targs = PyTuple_New(nargs);
+    for (Py_ssize_t i = 0; i < nargs; ++i) {
+      Py_INCREF(args[i]);
+      PyTuple_SET_ITEM(targs, i, args[i]);
+    }
+    PyObject *kwargs = nullptr;
+    if (kwnames) {
+      kwargs = PyDict_New();
+      for (Py_ssize_t k = 0, n = PyTuple_GET_SIZE(kwnames); k < n; ++k)
+        PyDict_SetItem(kwargs, PyTuple_GET_ITEM(kwnames, k), args[nargs + k]);
+    }
+    raise_invalid_argument(name, alternatives, targs, kwargs);
+    Py_DECREF(targs);
+    Py_XDECREF(kwargs);
+    return nullptr;
+  }
+#endif
 }
 
 PYTHONIC_NS_END
@@ -0,0 +1,146 @@
+#ifndef PYTHONIC_TYPES_BORROWED_DICT_HPP
+#define PYTHONIC_TYPES_BORROWED_DICT_HPP
+
+#include "pythonic/include/types/borrowed_dict.hpp"
+#include "pythonic/types/dict.hpp"
+#include "pythonic/__builtin__/KeyError.hpp"
+
+#ifdef ENABLE_PYTHON_MODULE
+
+PYTHONIC_NS_BEGIN
+
+namespace types
+{
+
+  /// borrowed_dict iterator
+
+  template <class K, class V>
+  borrowed_dict<K, V>::iterator::iterator(PyObject *obj, Py_ssize_t pos)
+      : obj(obj), pos(pos), key(nullptr)
+  {
+    if (pos >= 0)
+      ++*this;
+  }
+
+  template <class K, class V>
+  K borrowed_dict<K, V>::iterator::operator*() const
+  {
+    return ::from_python<K>(key);
+  }
+
+  template <class K, class V>
+  typename borrowed_dict<K, V>::iterator &borrowed_dict<K, V>::iterator::
+  operator++()
+  {
+    // a negative position marks the end
+    if (!PyDict_Next(obj, &pos, &key, nullptr))
+      pos = -1;
+    return *this;
+  }
+
+  template <class K, class V>
+  bool borrowed_dict<K, V>::iterator::operator==(iterator const &other) const
+  {
+    return pos == other.pos;
+  }
+
+  template <class K, class V>
+  bool borrowed_dict<K, V>::iterator::operator!=(iterator const &other) const
+  {
+    return pos != other.pos;
+  }
+
+  template <class K, class V>
+  bool borrowed_dict<K, V>::iterator::operator<(iterator const &other) const
+  {
+    return pos != other.pos;
+  }
+
+  /// borrowed_dict implementation
+
+  template <class K, class V>
+  borrowed_dict<K, V>::borrowed_dict(PyObject *obj)
+      : obj(obj)
+  {
+  }
+
+  template <class K, class V>
+  typename borrowed_dict<K, V>::iterator borrowed_dict<K, V>::begin() const
+  {
+    return {obj, 0};
+  }
+
+  template <class K, class V>
+  typename borrowed_dict<K, V>::iterator borrowed_dict<K, V>::end() const
+  {
+    return {obj, -1};
+  }
+
+  template <class K, class V>
+  long borrowed_dict<K, V>::size() const
+  {
+    return PyDict_Size(obj);
+  }
+
+  template <class K, class V>
+  borrowed_dict<K, V>::operator bool() const
+  {
+    return size();
+  }
+
+  template <class K, class V>
+  V borrowed_dict<K, V>::operator[](K const &key) const
+  {
+    return fast(key);
+  }
+
+  template <class K, class V>
+  V borrowed_dict<K, V>::fast(K const &key) const
+  {
+    PyObject *pykey = ::to_python(key);
+    PyObject *value = PyDict_GetItem(obj, pykey);
+    Py_DECREF(pykey);
+    if (!value)
+      throw KeyError(key);
+    return ::from_python<V>(value);
+  }
+
+  template <class K, class V>
+  bool borrowed_dict<K, V>::contains(K const &key) const
+  {
+    PyObject *pykey = ::to_python(key);
+    bool found = PyDict_GetItem(obj, pykey);
+    Py_DECREF(pykey);
+    return found;
+  }
+}
+PYTHONIC_NS_END
+
+namespace std
+{
+  template <size_t I, class K, class V>
+  V get(pythonic::types::borrowed_dict<K, V> const &d)
+  {
+    return d[I];
+  }
+}
+
+PYTHONIC_NS_BEGIN
+
+template <class K, class V>
+bool from_python<types::borrowed_dict<K, V>>::is_convertible(PyObject *obj)
+{
+  return ::is_convertible<types::dict<K, V>>(obj);
+}
+
+template <class K, class V>
+types::borrowed_dict<K, V>
+from_python<types::borrowed_dict<K, V>>::convert(PyObject *obj)
+{
+  return {obj};
+}
+PYTHONIC_NS_END
+
+#endif
+
+#endif
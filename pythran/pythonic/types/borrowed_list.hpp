@@ -0,0 +1,156 @@
+#ifndef PYTHONIC_TYPES_BORROWED_LIST_HPP
+#define PYTHONIC_TYPES_BORROWED_LIST_HPP
+
+#include "pythonic/include/types/borrowed_list.hpp"
+#include "pythonic/types/list.hpp"
+
+#ifdef ENABLE_PYTHON_MODULE
+
+PYTHONIC_NS_BEGIN
+
+namespace types
+{
+
+  /// borrowed_list iterator
+
+  template <class T>
+  borrowed_list<T>::iterator::iterator(PyObject *const *curr)
+      : curr(curr)
+  {
+  }
+
+  template <class T>
+  T borrowed_list<T>::iterator::operator*() const
+  {
+    return ::from_python<T>(*curr);
+  }
+
+  template <class T>
+  typename borrowed_list<T>::iterator &borrowed_list<T>::iterator::
+  operator++()
+  {
+    ++curr;
+    return *this;
+  }
+
+  template <class T>
+  typename borrowed_list<T>::iterator &borrowed_list<T>::iterator::
+  operator--()
+  {
+    --curr;
+    return *this;
+  }
+
+  template <class T>
+  typename borrowed_list<T>::iterator &borrowed_list<T>::iterator::
+  operator+=(long n)
+  {
+    curr += n;
+    return *this;
+  }
+
+  template <class T>
+  typename borrowed_list<T>::iterator borrowed_list<T>::iterator::
+  operator+(long n) const
+  {
+    return {curr + n};
+  }
+
+  template <class T>
+  long borrowed_list<T>::iterator::operator-(iterator const &other) const
+  {
+    return curr - other.curr;
+  }
+
+  template <class T>
+  bool borrowed_list<T>::iterator::operator==(iterator const &other) const
+  {
+    return curr == other.curr;
+  }
+
+  template <class T>
+  bool borrowed_list<T>::iterator::operator!=(iterator const &other) const
+  {
+    return curr != other.curr;
+  }
+
+  template <class T>
+  bool borrowed_list<T>::iterator::operator<(iterator const &other) const
+  {
+    return curr < other.curr;
+  }
+
+  /// borrowed_list implementation
+
+  template <class T>
+  borrowed_list<T>::borrowed_list(PyObject *obj)
+      : obj(obj)
+  {
+  }
+
+  template <class T>
+  typename borrowed_list<T>::iterator borrowed_list<T>::begin() const
+  {
+    return {PySequence_Fast_ITEMS(obj)};
+  }
+
+  template <class T>
+  typename borrowed_list<T>::iterator borrowed_list<T>::end() const
+  {
+    return {PySequence_Fast_ITEMS(obj) + size()};
+  }
+
+  template <class T>
+  long borrowed_list<T>::size() const
+  {
+    return PyList_GET_SIZE(obj);
+  }
+
+  template <class T>
+  borrowed_list<T>::operator bool() const
+  {
+    return size();
+  }
+
+  template <class T>
+  T borrowed_list<T>::operator[](long i) const
+  {
+    return fast(i < 0 ? i + size() : i);
+  }
+
+  template <class T>
+  T borrowed_list<T>::fast(long i) const
+  {
+    return ::from_python<T>(PyList_GET_ITEM(obj, i));
+  }
+}
+PYTHONIC_NS_END
+
+namespace std
+{
+  template <size_t I, class T>
+  T get(pythonic::types::borrowed_list<T> const &t)
+  {
+    return t[I];
+  }
+}
+
+PYTHONIC_NS_BEGIN
+
+template <class T>
+bool from_python<types::borrowed_list<T>>::is_convertible(PyObject *obj)
+{
+  return ::is_convertible<types::list<T>>(obj);
+}
+
+template <class T>
+types::borrowed_list<T>
+from_python<types::borrowed_list<T>>::convert(PyObject *obj)
+{
+  return {obj};
+}
+PYTHONIC_NS_END
+
+#endif
+
+#endif
@@ -9,6 +9,7 @@
 #include "pythonic/utils/reserve.hpp"
 #include "pythonic/__builtin__/None.hpp"
 #include "pythonic/utils/shared_ref.hpp"
+#include "pythonic/utils/flat_hash_map.hpp"
 
 #include <memory>
 #include <utility>
@@ -448,12 +449,11 @@ namespace types
   template <class K, class V>
   make_tuple_t<K, V> dict<K, V>::popitem()
   {
-    auto b = data->begin();
-    if (b == data->end())
+    if (data->empty())
       throw std::range_error("KeyError");
     else {
-      auto r = *b;
-      data->erase(b);
+      // LIFO order, as in Python
+      auto r = data->pop_back();
       return make_tuple_t<K, V>{r.first, r.second};
     }
   }
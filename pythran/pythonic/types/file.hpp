@@ -14,12 +14,15 @@
 #include "pythonic/__builtin__/RuntimeError.hpp"
 #include "pythonic/__builtin__/StopIteration.hpp"
 
+#include <algorithm>
 #include <fstream>
 #include <iterator>
 #include <cstring>
 #include <string>
 #include <cstdio>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 PYTHONIC_NS_BEGIN
 
@@ -28,14 +31,21 @@ namespace types
 
   /// _file implementation
 
-  _file::_file() : f(nullptr)
+  _file::_file()
+      : f(nullptr), buffered(false), buffer(utils::no_memory()), first(0),
+        last(0)
   {
   }
 
   // TODO : no check on file existance?
   _file::_file(types::str const &filename, types::str const &strmode)
-      : f(fopen(filename.c_str(), strmode.c_str()))
+      : f(fopen(filename.get_data().c_str(), strmode.get_data().c_str())),
+        buffered(false), buffer(utils::no_memory()), first(0), last(0)
   {
+    struct stat st;
+    // pipes && terminals are read line by line, so as ! to wait for a
+    // whole block
+    buffered = f && !fstat(::fileno(f), &st) && S_ISREG(st.st_mode);
   }
 
   FILE *_file::operator*() const
@@ -49,6 +59,46 @@ namespace types
       fclose(f);
   }
 
+  size_t _file::pending() const
+  {
+    return last - first;
+  }
+
+  bool _file::fill()
+  {
+    size_t count = pending();
+    size_t capacity = std::max<size_t>(PYTHRAN_FILE_BUFFER_SIZE, 2 * count);
+    // lines handed out may still refer to the current buffer
+    if (!buffer || !buffer.unique() || buffer->size() < capacity) {
+      utils::shared_ref<std::string> fresh(capacity, '\0');
+      if (count)
+        memcpy(&(*fresh)[0], buffer->data() + first, count);
+      buffer = fresh;
+    } else
+      memmove(&(*buffer)[0], buffer->data() + first, count);
+    first = 0;
+    last = count;
+    size_t n = fread(&(*buffer)[last], 1, buffer->size() - last, f);
+    last += n;
+    return n != 0;
+  }
+
+  void _file::unread()
+  {
+    if (pending())
+      fseek(f, -static_cast<long>(pending()), SEEK_CUR);
+    first = last = 0;
+  }
+
+  types::str _file::consume(size_t n)
+  {
+    if (!n)
+      return {};
+    types::str res(buffer, first, n);
+    first += n;
+    return res;
+  }
+
   /// file implementation
 
   // Constructors
@@ -76,7 +126,8 @@ namespace types
   // Modifiers
   void file::open(types::str const &filename, types::str const &strmode)
   {
-    const char *smode = strmode.c_str();
+    auto const mode = strmode.get_data();
+    const char *smode = mode.c_str();
     // Python enforces that the mode, after stripping 'U', begins with 'r',
     // 'w' || 'a'.
     if (*smode == 'U') {
@@ -93,6 +144,7 @@ namespace types
   {
     fclose(**data);
     data->f = nullptr;
+    data->first = data->last = 0;
     is_open = false;
   }
 
@@ -119,13 +171,14 @@ namespace types
 
   bool file::eof()
   {
-    return ::feof(**data);
+    return !data->pending() && ::feof(**data);
   }
 
   void file::flush()
   {
     if (!is_open)
       throw ValueError("I/O operation on closed file");
+    data->unread();
     fflush(**data);
   }
 
@@ -147,7 +200,7 @@ namespace types
   {
     if (!is_open)
       throw ValueError("I/O operation on closed file");
-    if (feof(**data) && mode.find_first_of("ra") == -1)
+    if (eof() && mode.find_first_of("ra") == -1)
       // If we are at eof on reading mode throw exception
       throw StopIteration("file.next() : EOF reached.");
     return readline();
@@ -159,18 +212,53 @@ namespace types
       throw ValueError("I/O operation on closed file");
     if (mode.find_first_of("r+") == -1)
       throw IOError("File ! open for reading");
-    if (size == 0 || (feof(**data) && mode.find_first_of("ra") == -1))
+    if (size == 0 || (eof() && mode.find_first_of("ra") == -1))
       return types::str();
-    long curr_pos = tell();
-    seek(0, SEEK_END);
-    size = size < 0 ? tell() - curr_pos : size;
-    seek(curr_pos);
-    char *content = new char[size + 1];
-    // This part needs a new implementation of types::str(char*) to avoid
-    // unnecessary copy.
-    types::str res(content, fread(content, sizeof(char), size, **data));
-    delete[] content;
-    return res;
+    _file &self = *data;
+    size_t count = self.pending();
+    if (size > 0 && size_t(size) <= count)
+      return self.consume(size);
+
+    // pending characters first, then the remaining ones straight from the
+    // file
+    std::string content(count ? self.buffer->data() + self.first : "", count);
+    self.first = self.last = 0;
+    FILE *f = **data;
+    struct stat st;
+    // files such as /proc ones have no size
+    if (!self.buffered || fstat(::fileno(f), &st) || !st.st_size) {
+      // unknown size, read by chunks until the end
+      char chunk[BUFSIZ];
+      size_t remaining = size < 0 ? -1 : size - count;
+      while (size_t n =
+                 fread(chunk, 1, std::min(sizeof(chunk), remaining), f)) {
+        content.append(chunk, n);
+        remaining -= n;
+      }
+      return {std::move(content)};
+    }
+    long start = ftell(f);
+    long available = std::max(0L, static_cast<long>(st.st_size) - start);
+    size = size < 0 ? available : std::min<long>(size - count, available);
+    if (size >= PYTHRAN_FILE_MMAP_THRESHOLD) {
+      // mapping the file saves the zero initialization of the result && the
+      // copy from the stdio buffer
+      long page = sysconf(_SC_PAGESIZE);
+      long base = start - start % page;
+      size_t length = size + (start - base);
+      void *map =
+          mmap(nullptr, length, PROT_READ, MAP_PRIVATE, ::fileno(f), base);
+      if (map != MAP_FAILED) {
+        madvise(map, length, MADV_SEQUENTIAL);
+        content.append(static_cast<char const *>(map) + (start - base), size);
+        munmap(map, length);
+        fseek(f, start + size, SEEK_SET);
+        return {std::move(content)};
+      }
+    }
+    content.resize(count + size);
+    content.resize(count + fread(&content[count], 1, size, f));
+    return {std::move(content)};
   }
 
   types::str file::readline(long size)
@@ -179,18 +267,38 @@ namespace types
       throw ValueError("I/O operation on closed file");
     if (mode.find_first_of("r+") == -1)
       throw IOError("File ! open for reading");
-    constexpr static long BUFFER_SIZE = 1024;
-    types::str res;
-    char read_str[BUFFER_SIZE];
-
-    for (long i = 0; i < size; i += BUFFER_SIZE) {
-      // +1 because we read the last chunk so we don't want to count \0
-      if (fgets(read_str, std::min(BUFFER_SIZE - 1, size - i) + 1, **data))
-        res += read_str;
-      if (feof(**data) || res[res.size() - 1] == "\n")
-        break;
+    _file &self = *data;
+    if (!self.buffered) {
+      constexpr static long BUFFER_SIZE = 1024;
+      types::str res;
+      char read_str[BUFFER_SIZE];
+
+      for (long i = 0; i < size; i += BUFFER_SIZE) {
+        // +1 because we read the last chunk so we don't want to count \0
+        if (fgets(read_str, std::min(BUFFER_SIZE - 1, size - i) + 1, **data))
+          res += read_str;
+        if (feof(**data) || res[res.size() - 1] == "\n")
+          break;
+      }
+      return res;
+    }
+
+    // characters already known ! to hold a newline
+    size_t scanned = 0;
+    while (true) {
+      size_t limit = std::min<size_t>(self.pending(), size);
+      if (limit > scanned) {
+        char const *start = self.buffer->data() + self.first;
+        if (auto eol = static_cast<char const *>(
+                memchr(start + scanned, '\n', limit - scanned)))
+          return self.consume(eol + 1 - start);
+      }
+      if (limit == size_t(size))
+        return self.consume(limit);
+      scanned = limit;
+      if (!self.fill())
+        return self.consume(self.pending());
     }
-    return res;
   }
 
   types::list<types::str> file::readlines(long sizehint)
@@ -204,12 +312,28 @@ namespace types
     return lst;
   }
 
+  long file::readinto(char *out, long size)
+  {
+    if (!is_open)
+      throw ValueError("I/O operation on closed file");
+    if (mode.find_first_of("r+") == -1)
+      throw IOError("File ! open for reading");
+    _file &self = *data;
+    size_t count = std::min<size_t>(self.pending(), size);
+    if (count) {
+      memcpy(out, self.buffer->data() + self.first, count);
+      self.first += count;
+    }
+    return count + fread(out + count, 1, size - count, **data);
+  }
+
   void file::seek(long offset, long whence)
   {
     if (!is_open)
       throw ValueError("I/O operation on closed file");
     if (whence != SEEK_SET && whence != SEEK_CUR && whence != SEEK_END)
       throw IOError("file.seek() :  Invalid argument.");
+    data->unread();
     fseek(**data, offset, whence);
   }
 
@@ -217,7 +341,7 @@ namespace types
   {
     if (!is_open)
       throw ValueError("I/O operation on closed file");
-    return ftell(**data);
+    return ftell(**data) - data->pending();
   }
 
   void file::truncate(long size)
@@ -228,18 +352,25 @@ namespace types
       throw IOError("file.write() :  File ! opened for writing.");
     if (size < 0)
       size = this->tell();
+    data->unread();
     long error = ftruncate(fileno(), size);
     if (error == -1)
       throw RuntimeError(strerror(errno));
   }
 
   void file::write(types::str const &str)
+  {
+    write(str.raw(), str.size());
+  }
+
+  void file::write(char const *in, long size)
   {
     if (!is_open)
       throw ValueError("I/O operation on closed file");
     if (mode.find_first_of("wa+") == -1)
       throw IOError("file.write() :  File ! opened for writing.");
-    fwrite(str.c_str(), sizeof(char), str.size(), **data);
+    data->unread();
+    fwrite(in, sizeof(char), size, **data);
   }
 
   template <class T>
@@ -256,7 +387,7 @@ namespace types
   // for line in open("myfile"):
   //     print line
   file_iterator::file_iterator(file &ref)
-      : f(ref), curr(ref.readline()), position(ref.tell())
+      : f(ref), curr(ref.readline()), position(curr ? 0 : -1)
   {
   }
 
@@ -282,11 +413,11 @@ namespace types
 
   file_iterator &file_iterator::operator++()
   {
-    // Check if ftell == -1 when fgetpos(FILE *stream, fpos_t eof) == 0
-    if (f.eof())
+    if (position == -1)
       return *this;
+    // only the end of file yields an empty line
     curr = f.readline();
-    position = f.eof() ? -1 : f.tell();
+    position = curr ? position + 1 : -1;
     return *this;
   }
 
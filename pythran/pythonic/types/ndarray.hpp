@@ -1403,6 +1403,29 @@ to_python<types::ndarray<T, pS>>::convert(types::ndarray<T, pS> const &cn,
       else
         return res;
     }
+  } else if (n.mem->is_mapped()) {
+    // numpy cannot release a file mapping, so the array keeps a reference
+    // to our memory instead of owning it
+    auto array = sutils::array(n._shape);
+    PyObject *result =
+        pyarray_new<long, std::tuple_size<pS>::value>{}.from_data(
+            array.data(), c_type_to_numpy_type<T>::value, n.buffer);
+    if (!result)
+      return nullptr;
+    if (!n.mem->is_writeable())
+      PyArray_CLEARFLAGS(reinterpret_cast<PyArrayObject *>(result),
+                         NPY_ARRAY_WRITEABLE);
+    using mem_type = utils::shared_ref<types::raw_array<T>>;
+    PyObject *capsule =
+        PyCapsule_New(new mem_type(n.mem), nullptr, [](PyObject *self) {
+          delete static_cast<mem_type *>(PyCapsule_GetPointer(self, nullptr));
+        });
+    PyArray_SetBaseObject(reinterpret_cast<PyArrayObject *>(result), capsule);
+    if (transpose)
+      return PyArray_Transpose(reinterpret_cast<PyArrayObject *>(result),
+                               nullptr);
+    else
+      return result;
   } else {
     auto array = sutils::array(n._shape);
     PyObject *result =
@@ -3,6 +3,12 @@
 
 #include "pythonic/include/types/raw_array.hpp"
 
+#include "pythonic/utils/allocate.hpp"
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
 PYTHONIC_NS_BEGIN
 
 namespace types
@@ -13,34 +19,54 @@ namespace types
    */
   template <class T>
   raw_array<T>::raw_array()
-      : data(nullptr), external(false)
+      : data(nullptr), external(false), writeable(true), mapping(nullptr),
+        nbytes(0)
   {
   }
 
   template <class T>
   raw_array<T>::raw_array(size_t n)
-      : data((T *)malloc(n * sizeof(T))), external(false)
+      : data((T *)utils::allocate(n * sizeof(T))), external(false),
+        writeable(true), mapping(nullptr), nbytes(n * sizeof(T))
   {
   }
 
   template <class T>
   raw_array<T>::raw_array(T *d, ownership o)
-      : data(d), external(o == ownership::external)
+      : data(d), external(o == ownership::external), writeable(true),
+        mapping(nullptr), nbytes(0)
+  {
+  }
+
+  template <class T>
+  raw_array<T>::raw_array(T *d, void *mapping, size_t size, bool writeable)
+      : data(d), external(true), writeable(writeable), mapping(mapping),
+        nbytes(size)
   {
   }
 
   template <class T>
   raw_array<T>::raw_array(raw_array<T> &&d)
-      : data(d.data), external(d.external)
+      : data(d.data), external(d.external), writeable(d.writeable),
+        mapping(d.mapping), nbytes(d.nbytes)
   {
     d.data = nullptr;
+    d.mapping = nullptr;
   }
 
   template <class T>
   raw_array<T>::~raw_array()
   {
-    if (data && !external)
-      free(data);
+    if (mapping) {
+#ifndef _WIN32
+      munmap(mapping, nbytes);
+#endif
+    } else if (data && !external) {
+      if (nbytes)
+        utils::deallocate(data, nbytes);
+      else
+        free(data);
+    }
   }
 
   template <class T>
@@ -48,6 +74,18 @@ namespace types
   {
     external = true;
   }
+
+  template <class T>
+  bool raw_array<T>::is_mapped() const
+  {
+    return mapping;
+  }
+
+  template <class T>
+  bool raw_array<T>::is_writeable() const
+  {
+    return writeable;
+  }
 }
 PYTHONIC_NS_END
 
@@ -10,6 +10,7 @@
 #include "pythonic/utils/functor.hpp"
 #include "pythonic/utils/int_.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <string>
 #include <cstring>
@@ -94,8 +95,13 @@ namespace types
   template <class S>
   sliced_str<S>::sliced_str(str const &other,
                             typename S::normalized_type const &s)
-      : data(other.data), slicing(s)
+      : data(other.shared()), slicing(s)
   {
+    // views start at some offset in their buffer
+    if (other.data) {
+      slicing.lower += other.span.offset;
+      slicing.upper += other.span.offset;
+    }
   }
 
   // const getter
@@ -122,8 +128,10 @@ namespace types
   template <class S>
   typename sliced_str<S>::const_iterator sliced_str<S>::end() const
   {
-    return typename sliced_str<S>::const_iterator(data->c_str() + slicing.upper,
-                                                  slicing.step);
+    // ! slicing.upper, which may ! be reached by steps of slicing.step
+    return typename sliced_str<S>::const_iterator(
+        data->c_str() + slicing.lower + slicing.size() * slicing.step,
+        slicing.step);
   }
 
   // size
@@ -233,48 +241,158 @@ namespace types
   }
 
   /// str implementation
-  str::str() : data()
+  str::str(utils::shared_ref<container_type> const &buffer, size_t pos,
+           size_t len)
+  {
+    if (len <= inline_size || len * view_ratio < buffer->size())
+      assign(buffer->data() + pos, len);
+    else {
+      data = buffer;
+      span = {pos, len};
+    }
+  }
+
+  bool str::is_view() const
+  {
+    return data && span.length != npos;
+  }
+
+  // the buffer of a string that shares it with no other
+  str::container_type &str::own()
+  {
+    if (!data || is_view() || !data.unique()) {
+      container_type chars(raw(), size());
+      data = utils::shared_ref<container_type>(std::move(chars));
+      span = {0, npos};
+    }
+    return *data;
+  }
+
+  // called after modifying the buffer, so that short strings are inline
+  void str::settle()
   {
+    if (data && data->size() <= inline_size)
+      assign(data->data(), data->size());
   }
 
-  str::str(std::string const &s) : data(s)
+  // buffer holding the characters of the string, at span.offset
+  utils::shared_ref<str::container_type> str::shared() const
   {
+    if (data)
+      return data;
+    return utils::shared_ref<container_type>(small.chars, small.size);
   }
 
-  str::str(std::string &&s) : data(std::move(s))
+  void str::assign(char const *s, size_t n)
   {
+    if (n <= inline_size) {
+      // s may point to our own characters, so the buffer is released last
+      std::memmove(small.chars, s, n);
+      small.size = n;
+      if (data)
+        data = utils::shared_ref<container_type>(utils::no_memory());
+    } else {
+      data = utils::shared_ref<container_type>(s, n);
+      span = {0, npos};
+    }
+  }
+
+  void str::assign(container_type &&s)
+  {
+    if (s.size() <= inline_size)
+      assign(s.data(), s.size());
+    else {
+      data = utils::shared_ref<container_type>(std::move(s));
+      span = {0, npos};
+    }
   }
 
-  str::str(const char *s) : data(s)
+  // the moved-from string is left empty
+  void str::take(str &other)
+  {
+    data = std::move(other.data);
+    if (data)
+      span = other.span;
+    else
+      small = other.small;
+    other.small.size = 0;
+  }
+
+  int str::compare(char const *self, size_t n, char const *other, size_t m)
+  {
+    int res = std::char_traits<char>::compare(self, other, std::min(n, m));
+    return res ? res : (n < m ? -1 : (n > m ? 1 : 0));
+  }
+
+  str::str()
+  {
+    small.size = 0;
+  }
+
+  str::str(str const &other)
+  {
+    // only moves, as for temporaries, keep a view
+    if (other.is_view())
+      assign(other.raw(), other.size());
+    else if (other.data) {
+      data = other.data;
+      span = other.span;
+    } else
+      small = other.small;
+  }
+
+  str::str(str &&other) noexcept
+  {
+    take(other);
+  }
+
+  str::str(std::string const &s) : str(std::string(s))
+  {
+  }
+
+  str::str(std::string &&s)
+  {
+    assign(std::move(s));
+  }
+
+  str::str(const char *s) : str(s, strlen(s))
   {
   }
 
   template <size_t N>
   str::str(const char(&s)[N])
-      : data(s)
+      : str(static_cast<const char *>(s))
   {
   }
 
-  str::str(const char *s, size_t n) : data(s, n)
+  str::str(const char *s, size_t n)
   {
+    assign(s, n);
   }
 
-  str::str(char c) : data(1, c)
+  str::str(char c)
   {
+    small.chars[0] = c;
+    small.size = 1;
   }
 
   template <class S>
   str::str(sliced_str<S> const &other)
-      : data(other.size(), 0)
   {
-    auto iter = chars().begin();
-    for (auto &&s : other)
-      *iter++ = s.chars()[0];
+    auto const &slicing = other.get_slice();
+    if (slicing.step == 1)
+      *this = str(other.data, slicing.lower, other.size());
+    else {
+      container_type out(other.size(), 0);
+      for (long i = 0; i < other.size(); ++i)
+        out[i] = other.get_data()[slicing.get(i)];
+      assign(std::move(out));
+    }
   }
 
   template <class T>
   str::str(T const &begin, T const &end)
-      : data(begin, end)
+      : str(std::string(begin, end))
   {
   }
 
@@ -283,23 +401,24 @@ namespace types
   {
     std::ostringstream oss;
     oss << s;
-    *data = oss.str();
+    assign(oss.str());
   }
 
   str::operator char() const
   {
     assert(size() == 1);
-    return (*data)[0];
+    return raw()[0];
   }
 
   str::operator long int() const
   { // Allows implicit conversion without loosing bool conversion
     char *endptr;
-    auto dat = data->data();
+    auto const chars = get_data();
+    auto dat = chars.c_str();
     long res = strtol(dat, &endptr, 10);
     if (endptr == dat) {
       std::ostringstream err;
-      err << "invalid literal for long() with base 10:'" << c_str() << '\'';
+      err << "invalid literal for long() with base 10:'" << chars << '\'';
       throw std::runtime_error(err.str());
     }
     return res;
@@ -308,11 +427,12 @@ namespace types
   str::operator float() const
   {
     char *endptr;
-    auto dat = data->data();
+    auto const chars = get_data();
+    auto dat = chars.c_str();
     float res = strtof(dat, &endptr);
     if (endptr == dat) {
       std::ostringstream err;
-      err << "invalid literal for float():'" << c_str() << "'";
+      err << "invalid literal for float():'" << chars << "'";
       throw std::runtime_error(err.str());
     }
     return res;
@@ -321,86 +441,122 @@ namespace types
   str::operator double() const
   {
     char *endptr;
-    auto dat = data->data();
+    auto const chars = get_data();
+    auto dat = chars.c_str();
     double res = strtod(dat, &endptr);
     if (endptr == dat) {
       std::ostringstream err;
-      err << "invalid literal for double():'" << c_str() << "'";
+      err << "invalid literal for double():'" << chars << "'";
       throw std::runtime_error(err.str());
     }
     return res;
   }
 
+  str &str::operator=(str const &other)
+  {
+    str tmp(other);
+    take(tmp);
+    return *this;
+  }
+
+  str &str::operator=(str &&other) noexcept
+  {
+    if (this != &other)
+      take(other);
+    return *this;
+  }
+
   template <class S>
   str &str::operator=(sliced_str<S> const &other)
   {
-    auto &other_data = other.get_data();
-    auto &other_slice = other.get_slice();
-    auto other_size = other.size();
-    data = decltype(data)(); // Don't use the original buffer
-    auto &my_data = *data;
-    long j = 0L;
-
-    if (other_size > size())
-      resize(other_size);
-    for (long i = other_slice.lower; i < other_slice.upper;
-         i = i + other_slice.step, j++)
-      my_data[j] = other_data[i];
-    if (j < size())
-      resize(j);
-    return *this;
+    return *this = str(other);
   }
 
   str &str::operator+=(str const &s)
   {
-    *data += *s.data;
+    size_t n = size(), m = s.size();
+    if (!data && n + m <= inline_size) {
+      // s may be *this, whose first n characters are left unchanged
+      std::memcpy(small.chars + n, s.raw(), m);
+      small.size = n + m;
+    } else {
+      auto &self = own();
+      self.append(s.raw(), m);
+    }
     return *this;
   }
 
-  str::container_type const &str::get_data() const
+  str::container_type str::get_data() const
   {
-    return *data;
+    return container_type(raw(), size());
   }
 
   long str::size() const
   {
-    return data->size();
+    return data ? (span.length == npos ? data->size() : span.length)
+                : small.size;
   }
 
   typename str::iterator str::begin() const
   {
-    return {data->begin()};
+    return {raw()};
   }
 
   typename str::reverse_iterator str::rbegin() const
   {
-    return {data->rbegin()};
+    return reverse_iterator(end());
   }
 
   typename str::iterator str::end() const
   {
-    return {data->end()};
+    return {raw() + size()};
   }
 
   typename str::reverse_iterator str::rend() const
   {
-    return {data->rend()};
+    return reverse_iterator(begin());
   }
 
-  auto str::c_str() const -> decltype(data->c_str())
+  char const *str::raw() const
   {
-    return data->c_str();
+    return data ? data->data() + span.offset : small.chars;
   }
 
-  auto str::resize(long n) -> decltype(data->resize(n))
+  char *str::chars()
   {
-    return data->resize(n);
+    return data ? &own()[0] : small.chars;
+  }
+
+  void str::resize(long n)
+  {
+    if (!data && size_t(n) <= inline_size) {
+      if (size_t(n) > small.size)
+        std::memset(small.chars + small.size, 0, n - small.size);
+      small.size = n;
+    } else {
+      own().resize(n);
+      settle();
+    }
   }
 
   long str::find(str const &s, size_t pos) const
   {
-    const char *res = strstr(c_str() + pos, s.c_str());
-    return res ? res - c_str() : -1;
+    size_t n = size(), m = s.size();
+    if (pos > n)
+      return -1;
+    if (!m)
+      return pos;
+    // look for the first character with memchr, then check the others
+    char const *first = raw(), *last = first + n, *needle = s.raw();
+    for (char const *iter = first + pos; size_t(last - iter) >= m; ++iter) {
+      iter = static_cast<char const *>(
+          memchr(iter, needle[0], last - iter - m + 1));
+      if (!iter)
+        return -1;
+      if (!memcmp(iter + 1, needle + 1, m - 1))
+        return iter - first;
+    }
+    return -1;
   }
 
   bool str::contains(str const &v) const
@@ -408,88 +564,150 @@ namespace types
     return find(v) != -1;
   }
 
+  namespace details
+  {
+    // membership test for the characters in [chars, chars + n), through a
+    // table for large sets
+    struct char_set {
+      char const *chars;
+      size_t n;
+      bool table[256];
+      char_set(char const *chars, size_t n) : chars(chars), n(n)
+      {
+        if (n > 8) {
+          std::fill(std::begin(table), std::end(table), false);
+          for (size_t i = 0; i < n; ++i)
+            table[static_cast<unsigned char>(chars[i])] = true;
+        }
+      }
+      bool operator()(char c) const
+      {
+        if (n > 8)
+          return table[static_cast<unsigned char>(c)];
+        for (size_t i = 0; i < n; ++i)
+          if (chars[i] == c)
+            return true;
+        return false;
+      }
+    };
+
+    // index of the first character of self[pos:n] that belongs, or !, to
+    // the character set [chars, chars + m), -1 if there is none
+    template <bool Belongs>
+    long find_first_in(char const *self, size_t pos, size_t n,
+                       char const *chars, size_t m)
+    {
+      if (pos >= n)
+        return -1;
+      if (Belongs && m == 1) {
+        auto res = memchr(self + pos, chars[0], n - pos);
+        return res ? static_cast<char const *>(res) - self : -1;
+      }
+      char_set set(chars, m);
+      for (size_t i = pos; i < n; ++i)
+        if (set(self[i]) == Belongs)
+          return i;
+      return -1;
+    }
+  }
+
   long str::find_first_of(str const &s, size_t pos) const
   {
-    return data->find_first_of(*s.data, pos);
+    return details::find_first_in<true>(raw(), pos, size(), s.raw(),
+                                        s.size());
   }
 
   long str::find_first_of(const char *s, size_t pos) const
   {
-    return data->find_first_of(s, pos);
+    return details::find_first_in<true>(raw(), pos, size(), s, strlen(s));
   }
 
   long str::find_first_not_of(str const &s, size_t pos) const
   {
-    return data->find_first_not_of(*s.data, pos);
+    return details::find_first_in<false>(raw(), pos, size(), s.raw(),
+                                         s.size());
   }
 
   long str::find_last_not_of(str const &s, size_t pos) const
   {
-    return data->find_last_not_of(*s.data, pos);
+    char const *self = raw();
+    details::char_set set(s.raw(), s.size());
+    for (size_t i = std::min<size_t>(pos, size() - 1) + 1; size() && i-- > 0;)
+      if (!set(self[i]))
+        return i;
+    return -1;
   }
 
   str str::substr(size_t pos, size_t len) const
   {
-    return data->substr(pos, len);
+    if (pos > size_t(size()))
+      throw std::out_of_range("str::substr");
+    len = std::min(len, size() - pos);
+    // short results are copied inline, longer ones share our buffer
+    if (len <= inline_size)
+      return str(raw() + pos, len);
+    return str(shared(), span.offset + pos, len);
   }
 
   bool str::empty() const
   {
-    return data->empty();
+    return !size();
   }
 
   int str::compare(size_t pos, size_t len, str const &str) const
   {
-    return data->compare(pos, len, *str.data);
+    return compare(raw() + pos, std::min(len, size() - pos), str.raw(),
+                   str.size());
   }
 
   void str::reserve(size_t n)
   {
-    data->reserve(n);
+    if (n > inline_size)
+      own().reserve(n);
   }
 
   str &str::replace(size_t pos, size_t len, str const &str)
   {
-    data->replace(pos, len, *str.data);
+    auto &self = own();
+    self.replace(pos, len, str.raw(), str.size());
+    settle();
     return *this;
   }
 
   template <class S>
   str &str::operator+=(sliced_str<S> const &other)
   {
-    resize(size() + other.get_data().size());
-    std::copy(other.begin(), other.end(), begin());
-    return *this;
+    return *this += str(other);
   }
 
   bool str::operator==(str const &other) const
   {
-    return *data == *other.data;
+    return size() == other.size() && !memcmp(raw(), other.raw(), size());
   }
 
   bool str::operator!=(str const &other) const
   {
-    return *data != *other.data;
+    return !(*this == other);
   }
 
   bool str::operator<=(str const &other) const
   {
-    return *data <= *other.data;
+    return compare(raw(), size(), other.raw(), other.size()) <= 0;
   }
 
   bool str::operator<(str const &other) const
   {
-    return *data < *other.data;
+    return compare(raw(), size(), other.raw(), other.size()) < 0;
   }
 
   bool str::operator>=(str const &other) const
   {
-    return *data >= *other.data;
+    return compare(raw(), size(), other.raw(), other.size()) >= 0;
   }
 
   bool str::operator>(str const &other) const
   {
-    return *data > *other.data;
+    return compare(raw(), size(), other.raw(), other.size()) > 0;
   }
 
   template <class S>
@@ -497,9 +715,10 @@ namespace types
   {
     if (size() != other.size())
       return false;
+    char const *self = raw();
     for (long i = other.get_slice().lower, j = 0L; j < size();
          i = i + other.get_slice().step, j++)
-      if (other.get_data()[i] != chars()[j])
+      if (other.get_data()[i] != self[j])
         return false;
     return true;
   }
@@ -518,12 +737,12 @@ namespace types
   {
     if (i < 0)
       i += size();
-    return str(fast(i));
+    return fast(i);
   }
 
   str str::fast(long i) const
   {
-    return str((*data)[i]);
+    return str(raw()[i]);
   }
 
   sliced_str<slice> str::operator[](slice const &s) const
@@ -538,7 +757,12 @@ namespace types
 
   str::operator bool() const
   {
-    return !data->empty();
+    return size() != 0;
+  }
+
+  intptr_t str::id() const
+  {
+    return std::hash<str>()(*this);
   }
 
   long str::count(types::str const &sub) const
@@ -555,7 +779,11 @@ namespace types
 
   str operator+(str const &self, str const &other)
   {
-    return str(self.get_data() + other.get_data());
+    std::string s;
+    s.reserve(self.size() + other.size());
+    s.append(self.raw(), self.size());
+    s.append(other.raw(), other.size());
+    return {std::move(s)};
   }
 
   template <size_t N>
@@ -563,7 +791,7 @@ namespace types
   {
     std::string s;
     s.reserve(self.size() + N);
-    s += self.get_data();
+    s.append(self.raw(), self.size());
     s += other;
     return {std::move(s)};
   }
@@ -574,7 +802,7 @@ namespace types
     std::string s;
     s.reserve(other.size() + N);
     s += self;
-    s += other.get_data();
+    s.append(other.raw(), other.size());
     return {std::move(s)};
   }
 
@@ -586,7 +814,7 @@ namespace types
 
   std::ostream &operator<<(std::ostream &os, str const &s)
   {
-    return os << s.c_str();
+    return os.write(s.raw(), s.size());
   }
 }
 
@@ -625,9 +853,9 @@ pythonic::types::str operator*(pythonic::types::str const &s, long n)
     return pythonic::types::str();
   pythonic::types::str other;
   other.resize(s.size() * n);
-  auto where = other.chars().begin();
+  char *where = other.chars();
   for (long i = 0; i < n; i++, where += s.size())
-    std::copy(s.chars().begin(), s.chars().end(), where);
+    std::copy(s.raw(), s.raw() + s.size(), where);
   return other;
 }
 
@@ -642,6 +870,10 @@ namespace std
   size_t hash<pythonic::types::str>::
   operator()(const pythonic::types::str &x) const
   {
+    // views && inline strings, that are short, need a copy of their
+    // characters
+    if (x.data && !x.is_view())
+      return hash<std::string>()(*x.data);
     return hash<std::string>()(x.get_data());
   }
 
@@ -672,7 +904,7 @@ PYTHONIC_NS_BEGIN
 
 PyObject *to_python<types::str>::convert(types::str const &v)
 {
-  return PyString_FromStringAndSize(v.c_str(), v.size());
+  return PyString_FromStringAndSize(v.raw(), v.size());
 }
 
 template <class S>
@@ -412,7 +412,8 @@ namespace
 
   inline size_t hash_combiner(size_t left, size_t right) // replacable
   {
-    return left ^ right;
+    // boost::hash_combine, so that permuted tuples do not collide
+    return left ^ (right + 0x9e3779b9 + (left << 6) + (left >> 2));
   }
 
   template <size_t index, class... types>
@@ -0,0 +1,176 @@
+#ifndef PYTHONIC_UTILS_ALLOCATE_HPP
+#define PYTHONIC_UTILS_ALLOCATE_HPP
+
+#include "pythonic/include/utils/allocate.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef PYTHRAN_ALLOCATOR_STATS
+#include <atomic>
+#endif
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  namespace details
+  {
+    // smallest size class, large enough to chain free buffers
+    constexpr size_t min_allocation = PYTHRAN_ALLOCATOR_ALIGNMENT < 64
+                                          ? 64
+                                          : PYTHRAN_ALLOCATOR_ALIGNMENT;
+    constexpr size_t size_classes = 4 * 8 * sizeof(size_t);
+
+    inline size_t log2(size_t n)
+    {
+#ifdef __GNUC__
+      return 8 * sizeof(unsigned long long) - 1 - __builtin_clzll(n);
+#else
+      size_t log = 0;
+      while (n >>= 1)
+        ++log;
+      return log;
+#endif
+    }
+
+    // index of the size class of `bytes`, which is updated to the size of
+    // that class
+    inline size_t size_class(size_t &bytes)
+    {
+      if (bytes <= min_allocation) {
+        bytes = min_allocation;
+        return 0;
+      }
+      size_t log = details::log2(bytes - 1);
+      size_t sub = (bytes - 1) >> (log - 2); // in [4, 8)
+      bytes = (sub + 1) << (log - 2);
+      return 4 * log + sub - 4 * details::log2(min_allocation) - 3;
+    }
+
+    /* Released buffers, chained through their first bytes.
+     *
+     * Trivially destructible, so that arrays released after the thread
+     * cleanup, e.g. global ones, can still check it is gone.
+     */
+    struct pool {
+      void *heads[size_classes];
+      size_t cached;
+      bool released;
+
+      void release()
+      {
+        for (void *&head : heads)
+          while (head) {
+            void *next = *static_cast<void **>(head);
+            free(head);
+            head = next;
+          }
+        cached = 0;
+        released = true;
+      }
+    };
+
+    struct pool_cleanup {
+      pool &instance;
+      ~pool_cleanup()
+      {
+        instance.release();
+      }
+    };
+
+    inline pool *local_pool()
+    {
+      static thread_local pool instance; // zero initialized
+      static thread_local pool_cleanup cleanup{instance};
+      return instance.released ? nullptr : &instance;
+    }
+
+#ifdef PYTHRAN_ALLOCATOR_STATS
+    struct allocator_counters {
+      std::atomic<long> allocations{0}, bytes{0}, pool_hits{0};
+
+      ~allocator_counters()
+      {
+        long n = allocations;
+        fprintf(stderr, "pythran allocator: %ld allocations, %ld bytes, "
+                        "%ld pool hits (%.1f%%)\n",
+                n, long(bytes), long(pool_hits),
+                n ? 100. * pool_hits / n : 0.);
+      }
+    };
+
+    inline allocator_counters &counters()
+    {
+      static allocator_counters instance;
+      return instance;
+    }
+#endif
+
+    inline void *system_allocate(size_t bytes)
+    {
+#ifdef _WIN32
+      // memory given to numpy must be released by free(), which rules out
+      // _aligned_malloc
+      void *buffer = malloc(bytes);
+#else
+      void *buffer;
+      if (posix_memalign(&buffer, PYTHRAN_ALLOCATOR_ALIGNMENT, bytes))
+        buffer = nullptr;
+#endif
+      if (!buffer)
+        throw std::bad_alloc();
+      return buffer;
+    }
+  }
+
+  void *allocate(size_t bytes)
+  {
+#ifdef PYTHRAN_ALLOCATOR_STATS
+    details::counters().allocations += 1;
+    details::counters().bytes += bytes;
+#endif
+#if PYTHRAN_ALLOCATOR_POOL_SIZE
+    size_t index = details::size_class(bytes);
+    if (details::pool *pool = details::local_pool())
+      if (void *head = pool->heads[index]) {
+        pool->heads[index] = *static_cast<void **>(head);
+        pool->cached -= bytes;
+#ifdef PYTHRAN_ALLOCATOR_STATS
+        details::counters().pool_hits += 1;
+#endif
+        return head;
+      }
+#endif
+    return details::system_allocate(bytes);
+  }
+
+  void deallocate(void *buffer, size_t bytes)
+  {
+#if PYTHRAN_ALLOCATOR_POOL_SIZE
+    size_t index = details::size_class(bytes);
+    if (details::pool *pool = details::local_pool())
+      if (pool->cached + bytes <= size_t(PYTHRAN_ALLOCATOR_POOL_SIZE)) {
+        *static_cast<void **>(buffer) = pool->heads[index];
+        pool->heads[index] = buffer;
+        pool->cached += bytes;
+        return;
+      }
+#endif
+    free(buffer);
+  }
+
+  allocator_stats get_allocator_stats()
+  {
+#ifdef PYTHRAN_ALLOCATOR_STATS
+    auto &c = details::counters();
+    return {c.allocations, c.bytes, c.pool_hits};
+#else
+    return {0, 0, 0};
+#endif
+  }
+}
+PYTHONIC_NS_END
+
+#endif
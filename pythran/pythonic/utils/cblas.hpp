@@ -0,0 +1,207 @@
+#ifndef PYTHONIC_UTILS_CBLAS_HPP
+#define PYTHONIC_UTILS_CBLAS_HPP
+
+#include "pythonic/include/utils/cblas.hpp"
+
+#include "pythonic/utils/gemm.hpp"
+
+#include <algorithm>
+#include <vector>
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  namespace details
+  {
+    // BLAS walks vectors with a negative increment from their end
+    template <class T>
+    vector_view<T> blas_vector(T const *x, int n, int incx)
+    {
+      return {incx < 0 ? x - long(n - 1) * incx : x, incx};
+    }
+
+    // View on the op(a) operand of a BLAS call
+    template <class T>
+    matrix_view<T> blas_matrix(CBLAS_ORDER order, CBLAS_TRANSPOSE trans,
+                               T const *a, int lda)
+    {
+      matrix_view<T> view = order == CblasRowMajor
+                                ? matrix_view<T>{a, lda, 1}
+                                : matrix_view<T>{a, 1, lda};
+      return trans == CblasNoTrans ? view : view.transpose();
+    }
+
+    template <class T>
+    T blas_dot(int n, T const *x, int incx, T const *y, int incy)
+    {
+      // independent partial sums, so that the reduction vectorizes
+      constexpr long lanes = 8;
+      vector_view<T> vx = blas_vector(x, n, incx), vy = blas_vector(y, n, incy);
+      T acc[lanes] = {};
+      long i = 0;
+      if (incx == 1 && incy == 1)
+        for (; i + lanes <= n; i += lanes)
+          for (long l = 0; l < lanes; ++l)
+            acc[l] += x[i + l] * y[i + l];
+      T res = T(0);
+      for (long l = 0; l < lanes; ++l)
+        res += acc[l];
+      for (; i < n; ++i)
+        res += vx[i] * vy[i];
+      return res;
+    }
+
+    template <class T>
+    void blas_gemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                   T alpha, T const *a, int lda, T const *x, int incx, T beta,
+                   T *y, int incy)
+    {
+      matrix_view<T> view = blas_matrix(order, trans, a, lda);
+      if (trans != CblasNoTrans)
+        std::swap(m, n);
+      vector_view<T> vx = blas_vector(x, n, incx);
+      if (alpha == T(1) && beta == T(0) && incy == 1) {
+        gemv(m, n, view, vx, y);
+        return;
+      }
+      std::vector<T> tmp(m);
+      gemv(m, n, view, vx, tmp.data());
+      if (incy < 0)
+        y -= long(m - 1) * incy;
+      for (long i = 0; i < m; ++i, y += incy)
+        // as in BLAS, y is not read when beta is zero
+        *y = alpha * tmp[i] + (beta == T(0) ? T(0) : beta * *y);
+    }
+
+    template <class T>
+    void blas_gemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                   CBLAS_TRANSPOSE transb, int m, int n, int k, T alpha,
+                   T const *a, int lda, T const *b, int ldb, T beta, T *c,
+                   int ldc)
+    {
+      matrix_view<T> va = blas_matrix(order, transa, a, lda);
+      matrix_view<T> vb = blas_matrix(order, transb, b, ldb);
+      if (order == CblasRowMajor && alpha == T(1) && beta == T(0) &&
+          ldc == n) {
+        gemm(m, n, k, va, vb, c);
+        return;
+      }
+      std::vector<T> tmp(long(m) * n);
+      gemm(m, n, k, va, vb, tmp.data());
+      long row_stride = order == CblasRowMajor ? ldc : 1;
+      long col_stride = order == CblasRowMajor ? 1 : ldc;
+      for (long i = 0; i < m; ++i)
+        for (long j = 0; j < n; ++j) {
+          T &out = c[i * row_stride + j * col_stride];
+          out = alpha * tmp[i * n + j] + (beta == T(0) ? T(0) : beta * out);
+        }
+    }
+  }
+}
+
+float cblas_sdot(int n, float const *x, int incx, float const *y, int incy)
+{
+  return utils::details::blas_dot(n, x, incx, y, incy);
+}
+
+double cblas_ddot(int n, double const *x, int incx, double const *y, int incy)
+{
+  return utils::details::blas_dot(n, x, incx, y, incy);
+}
+
+void cblas_cdotu_sub(int n, void const *x, int incx, void const *y, int incy,
+                     void *dotu)
+{
+  using T = std::complex<float>;
+  *(T *)dotu = utils::details::blas_dot(n, (T const *)x, incx, (T const *)y,
+                                        incy);
+}
+
+void cblas_zdotu_sub(int n, void const *x, int incx, void const *y, int incy,
+                     void *dotu)
+{
+  using T = std::complex<double>;
+  *(T *)dotu = utils::details::blas_dot(n, (T const *)x, incx, (T const *)y,
+                                        incy);
+}
+
+void cblas_sgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 float alpha, float const *a, int lda, float const *x,
+                 int incx, float beta, float *y, int incy)
+{
+  utils::details::blas_gemv(order, trans, m, n, alpha, a, lda, x, incx, beta,
+                            y, incy);
+}
+
+void cblas_dgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 double alpha, double const *a, int lda, double const *x,
+                 int incx, double beta, double *y, int incy)
+{
+  utils::details::blas_gemv(order, trans, m, n, alpha, a, lda, x, incx, beta,
+                            y, incy);
+}
+
+void cblas_cgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 void const *alpha, void const *a, int lda, void const *x,
+                 int incx, void const *beta, void *y, int incy)
+{
+  using T = std::complex<float>;
+  utils::details::blas_gemv(order, trans, m, n, *(T const *)alpha,
+                            (T const *)a, lda, (T const *)x, incx,
+                            *(T const *)beta, (T *)y, incy);
+}
+
+void cblas_zgemv(CBLAS_ORDER order, CBLAS_TRANSPOSE trans, int m, int n,
+                 void const *alpha, void const *a, int lda, void const *x,
+                 int incx, void const *beta, void *y, int incy)
+{
+  using T = std::complex<double>;
+  utils::details::blas_gemv(order, trans, m, n, *(T const *)alpha,
+                            (T const *)a, lda, (T const *)x, incx,
+                            *(T const *)beta, (T *)y, incy);
+}
+
+void cblas_sgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k, float alpha,
+                 float const *a, int lda, float const *b, int ldb, float beta,
+                 float *c, int ldc)
+{
+  utils::details::blas_gemm(order, transa, transb, m, n, k, alpha, a, lda, b,
+                            ldb, beta, c, ldc);
+}
+
+void cblas_dgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k, double alpha,
+                 double const *a, int lda, double const *b, int ldb,
+                 double beta, double *c, int ldc)
+{
+  utils::details::blas_gemm(order, transa, transb, m, n, k, alpha, a, lda, b,
+                            ldb, beta, c, ldc);
+}
+
+void cblas_cgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k,
+                 void const *alpha, void const *a, int lda, void const *b,
+                 int ldb, void const *beta, void *c, int ldc)
+{
+  using T = std::complex<float>;
+  utils::details::blas_gemm(order, transa, transb, m, n, k, *(T const *)alpha,
+                            (T const *)a, lda, (T const *)b, ldb,
+                            *(T const *)beta, (T *)c, ldc);
+}
+
+void cblas_zgemm(CBLAS_ORDER order, CBLAS_TRANSPOSE transa,
+                 CBLAS_TRANSPOSE transb, int m, int n, int k,
+                 void const *alpha, void const *a, int lda, void const *b,
+                 int ldb, void const *beta, void *c, int ldc)
+{
+  using T = std::complex<double>;
+  utils::details::blas_gemm(order, transa, transb, m, n, k, *(T const *)alpha,
+                            (T const *)a, lda, (T const *)b, ldb,
+                            *(T const *)beta, (T *)c, ldc);
+}
+
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,537 @@
+#ifndef PYTHONIC_UTILS_FLAT_HASH_MAP_HPP
+#define PYTHONIC_UTILS_FLAT_HASH_MAP_HPP
+
+#include "pythonic/include/utils/flat_hash_map.hpp"
+
+#include <algorithm>
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  namespace details
+  {
+    inline int highest_bit(size_t value)
+    {
+#if defined(__GNUC__)
+      return 8 * sizeof(unsigned long long) - 1 - __builtin_clzll(value);
+#else
+      int n = -1;
+      while (value) {
+        value >>= 1;
+        ++n;
+      }
+      return n;
+#endif
+    }
+  }
+
+#define FLAT_HASH_MAP_TEMPLATE                                                 \
+  template <class K, class V, class Hash, class KeyEqual>
+#define FLAT_HASH_MAP flat_hash_map<K, V, Hash, KeyEqual>
+
+  FLAT_HASH_MAP_TEMPLATE
+  constexpr size_t FLAT_HASH_MAP::min_capacity;
+  FLAT_HASH_MAP_TEMPLATE
+  constexpr size_t FLAT_HASH_MAP::first_chunk_size;
+  FLAT_HASH_MAP_TEMPLATE
+  constexpr uint32_t FLAT_HASH_MAP::empty_slot;
+  FLAT_HASH_MAP_TEMPLATE
+  constexpr uint32_t FLAT_HASH_MAP::deleted_slot;
+
+  /// iterators
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  FLAT_HASH_MAP::basic_iterator<Map, Value>::basic_iterator()
+      : map(nullptr), index(0), value(nullptr)
+  {
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  FLAT_HASH_MAP::basic_iterator<Map, Value>::basic_iterator(Map *map,
+                                                            size_t index)
+      : map(map), index(index),
+        value(index < map->count_ ? &map->entry_at(index).kv : nullptr)
+  {
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  FLAT_HASH_MAP::basic_iterator<Map, Value>::basic_iterator(Map *map,
+                                                            size_t index,
+                                                            Value *value)
+      : map(map), index(index), value(value)
+  {
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  template <class OtherMap, class OtherValue>
+  FLAT_HASH_MAP::basic_iterator<Map, Value>::basic_iterator(
+      basic_iterator<OtherMap, OtherValue> const &other)
+      : map(other.map), index(other.index), value(other.value)
+  {
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  Value &FLAT_HASH_MAP::basic_iterator<Map, Value>::operator*() const
+  {
+    return *value;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  Value *FLAT_HASH_MAP::basic_iterator<Map, Value>::operator->() const
+  {
+    return value;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  typename FLAT_HASH_MAP::template basic_iterator<Map, Value> &
+      FLAT_HASH_MAP::basic_iterator<Map, Value>::operator++()
+  {
+    return *this = basic_iterator(map, map->next_live(index + 1));
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  typename FLAT_HASH_MAP::template basic_iterator<Map, Value>
+      FLAT_HASH_MAP::basic_iterator<Map, Value>::operator++(int)
+  {
+    basic_iterator self = *this;
+    ++*this;
+    return self;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  bool FLAT_HASH_MAP::basic_iterator<Map, Value>::
+  operator==(basic_iterator const &other) const
+  {
+    return index == other.index;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Map, class Value>
+  bool FLAT_HASH_MAP::basic_iterator<Map, Value>::
+  operator!=(basic_iterator const &other) const
+  {
+    return index != other.index;
+  }
+
+  /// hashing
+
+  FLAT_HASH_MAP_TEMPLATE
+  uint32_t FLAT_HASH_MAP::tag(size_t hash)
+  {
+    return uint32_t(hash);
+  }
+
+  // std::hash is the identity for integers: multiplying by 2^64 / phi
+  // spreads consecutive keys over the high bits, which select the slot.
+  // This is cheaper than a full mix on the critical path of lookups.
+  FLAT_HASH_MAP_TEMPLATE
+  size_t FLAT_HASH_MAP::home(size_t hash) const
+  {
+    return (uint64_t(hash) * 0x9E3779B97F4A7C15ULL) >> shift_;
+  }
+
+  // at most three slots out of four are full || deleted, which keeps
+  // linear probing sequences short
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::size_type FLAT_HASH_MAP::max_load(size_type capacity)
+  {
+    return capacity - capacity / 4;
+  }
+
+  /// entry storage
+
+  FLAT_HASH_MAP_TEMPLATE
+  size_t FLAT_HASH_MAP::chunk_size(size_t chunk)
+  {
+    return first_chunk_size << chunk;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::entry &FLAT_HASH_MAP::entry_at(size_t index)
+  {
+    size_t biased = index + first_chunk_size;
+    int bit = details::highest_bit(biased);
+    return chunks_[bit - details::highest_bit(first_chunk_size)]
+                  [biased - (size_t(1) << bit)];
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::entry const &
+  FLAT_HASH_MAP::entry_at(size_t index) const
+  {
+    return const_cast<flat_hash_map &>(*this).entry_at(index);
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::push_entry(entry &&e)
+  {
+    if (chunks_.empty() ||
+        chunks_.back().size() == chunk_size(chunks_.size() - 1)) {
+      chunks_.emplace_back();
+      chunks_.back().reserve(chunk_size(chunks_.size() - 1));
+    }
+    chunks_.back().push_back(std::move(e));
+    ++count_;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::pop_entry()
+  {
+    chunks_.back().pop_back();
+    if (chunks_.back().empty())
+      chunks_.pop_back();
+    --count_;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  size_t FLAT_HASH_MAP::next_live(size_t index) const
+  {
+    while (index < count_ && !entry_at(index).live)
+      ++index;
+    return index;
+  }
+
+  /// probing
+
+  FLAT_HASH_MAP_TEMPLATE
+  size_t FLAT_HASH_MAP::hash_of(K const &key) const
+  {
+    return Hash{}(key);
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::size_type FLAT_HASH_MAP::capacity() const
+  {
+    return slots_.size();
+  }
+
+  // inlined into lookup loops, it lets the processor overlap the memory
+  // accesses of successive lookups
+  FLAT_HASH_MAP_TEMPLATE
+  inline typename FLAT_HASH_MAP::entry *
+  FLAT_HASH_MAP::find_entry(K const &key, size_t hash, size_t &index) const
+  {
+    if (slots_.empty())
+      return nullptr;
+    size_t mask = slots_.size() - 1;
+    uint32_t bits = tag(hash);
+    // a matching tag is the likely outcome, test it first
+    for (size_t pos = home(hash);; pos = (pos + 1) & mask) {
+      slot const &s = slots_[pos];
+      if (s.hash == bits && s.index < deleted_slot) {
+        entry const &e = entry_at(s.index);
+        if (KeyEqual{}(e.kv.first, key)) {
+          index = s.index;
+          return const_cast<entry *>(&e);
+        }
+      }
+      if (s.index == empty_slot)
+        return nullptr;
+    }
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  size_t FLAT_HASH_MAP::find_insert_slot(size_t hash) const
+  {
+    size_t mask = slots_.size() - 1;
+    size_t pos = home(hash);
+    while (slots_[pos].index < deleted_slot)
+      pos = (pos + 1) & mask;
+    return pos;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::set_slot(size_t pos, size_t hash, uint32_t index)
+  {
+    slots_[pos] = slot{tag(hash), index};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::rehash(size_type capacity)
+  {
+    slots_.assign(capacity, slot{0, empty_slot});
+    shift_ = 64 - details::highest_bit(capacity);
+    for (size_t i = 0; i < count_; ++i) {
+      entry const &e = entry_at(i);
+      if (e.live)
+        set_slot(find_insert_slot(e.hash), e.hash, i);
+    }
+    growth_left_ = max_load(capacity) - size_;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::compact()
+  {
+    std::vector<std::vector<entry>> chunks;
+    chunks.swap(chunks_);
+    count_ = holes_ = 0;
+    for (auto &chunk : chunks)
+      for (auto &e : chunk)
+        if (e.live)
+          push_entry(std::move(e));
+    rehash(capacity());
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::drop_trailing_holes()
+  {
+    while (count_ && !entry_at(count_ - 1).live) {
+      pop_entry();
+      --holes_;
+    }
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Kp, class Vp>
+  typename FLAT_HASH_MAP::iterator
+  FLAT_HASH_MAP::emplace_new(size_t hash, Kp &&key, Vp &&value)
+  {
+    if (!growth_left_) {
+      // Either grow, or only sweep deleted slots if there are many. Entries
+      // are not moved, so references to them stay valid.
+      size_type capacity = std::max(min_capacity, this->capacity());
+      while ((size_ + 1) * 2 > max_load(capacity))
+        capacity *= 2;
+      rehash(capacity);
+    }
+    size_t pos = find_insert_slot(hash);
+    growth_left_ -= slots_[pos].index == empty_slot;
+    set_slot(pos, hash, count_);
+    push_entry(entry{value_type(std::forward<Kp>(key), std::forward<Vp>(value)),
+                     hash, true});
+    ++size_;
+    return {this, count_ - 1};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::erase_index(size_t index)
+  {
+    // look for the slot by position rather than by key
+    entry &e = entry_at(index);
+    size_t mask = slots_.size() - 1;
+    size_t pos = home(e.hash);
+    while (slots_[pos].index != index)
+      pos = (pos + 1) & mask;
+    slots_[pos].index = deleted_slot;
+    e.live = false;
+    --size_;
+    ++holes_;
+  }
+
+  /// public interface
+
+  FLAT_HASH_MAP_TEMPLATE
+  FLAT_HASH_MAP::flat_hash_map()
+      : count_(0), size_(0), holes_(0), growth_left_(0), shift_(64)
+  {
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  FLAT_HASH_MAP::flat_hash_map(size_type capacity)
+      : flat_hash_map()
+  {
+    size_type n = min_capacity;
+    while (max_load(n) < capacity)
+      n *= 2;
+    rehash(n);
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class I>
+  FLAT_HASH_MAP::flat_hash_map(I first, I last)
+      : flat_hash_map()
+  {
+    // as in Python, the last occurrence of a key wins
+    for (; first != last; ++first)
+      insert_or_assign(std::get<0>(*first), std::get<1>(*first));
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  FLAT_HASH_MAP::flat_hash_map(flat_hash_map const &other)
+      : slots_(other.slots_), count_(other.count_), size_(other.size_),
+        holes_(other.holes_), growth_left_(other.growth_left_),
+        shift_(other.shift_)
+  {
+    chunks_.reserve(other.chunks_.size());
+    for (auto const &chunk : other.chunks_) {
+      chunks_.emplace_back();
+      chunks_.back().reserve(chunk_size(chunks_.size() - 1));
+      chunks_.back().insert(chunks_.back().end(), chunk.begin(), chunk.end());
+    }
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  FLAT_HASH_MAP::flat_hash_map(flat_hash_map &&other) : flat_hash_map()
+  {
+    *this = std::move(other);
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  FLAT_HASH_MAP &FLAT_HASH_MAP::operator=(flat_hash_map const &other)
+  {
+    if (this != &other)
+      *this = flat_hash_map(other);
+    return *this;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  FLAT_HASH_MAP &FLAT_HASH_MAP::operator=(flat_hash_map &&other)
+  {
+    if (this == &other)
+      return *this;
+    slots_ = std::move(other.slots_);
+    chunks_ = std::move(other.chunks_);
+    count_ = other.count_;
+    size_ = other.size_;
+    holes_ = other.holes_;
+    growth_left_ = other.growth_left_;
+    shift_ = other.shift_;
+    // moved-from vectors are only valid, make them empty
+    other.slots_.clear();
+    other.chunks_.clear();
+    other.count_ = other.size_ = other.holes_ = other.growth_left_ = 0;
+    other.shift_ = 64;
+    return *this;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::iterator FLAT_HASH_MAP::begin()
+  {
+    return {this, next_live(0)};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::const_iterator FLAT_HASH_MAP::begin() const
+  {
+    return {this, next_live(0)};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::iterator FLAT_HASH_MAP::end()
+  {
+    return {this, count_};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::const_iterator FLAT_HASH_MAP::end() const
+  {
+    return {this, count_};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  bool FLAT_HASH_MAP::empty() const
+  {
+    return size_ == 0;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::size_type FLAT_HASH_MAP::size() const
+  {
+    return size_;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  V &FLAT_HASH_MAP::operator[](K const &key)
+  {
+    size_t hash = hash_of(key);
+    size_t index;
+    if (entry *e = find_entry(key, hash, index))
+      return e->kv.second;
+    return emplace_new(hash, key, V())->second;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::iterator FLAT_HASH_MAP::find(K const &key)
+  {
+    size_t index;
+    if (entry *e = find_entry(key, hash_of(key), index))
+      return {this, index, &e->kv};
+    return end();
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::const_iterator
+  FLAT_HASH_MAP::find(K const &key) const
+  {
+    size_t index;
+    if (entry const *e = find_entry(key, hash_of(key), index))
+      return {this, index, &e->kv};
+    return end();
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  template <class Kp, class Vp>
+  std::pair<typename FLAT_HASH_MAP::iterator, bool>
+  FLAT_HASH_MAP::insert_or_assign(Kp &&key, Vp &&value)
+  {
+    size_t hash = hash_of(key);
+    size_t index;
+    if (entry *e = find_entry(key, hash, index)) {
+      e->kv.second = std::forward<Vp>(value);
+      return {iterator(this, index, &e->kv), false};
+    }
+    return {emplace_new(hash, std::forward<Kp>(key), std::forward<Vp>(value)),
+            true};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::iterator FLAT_HASH_MAP::erase(const_iterator pos)
+  {
+    size_t index = pos.index;
+    erase_index(index);
+    drop_trailing_holes();
+    if (holes_ > size_ && holes_ >= first_chunk_size) {
+      // compaction renumbers entries: locate the next one by counting
+      size_t rank = 0;
+      for (size_t i = 0; i < std::min(index, count_); ++i)
+        rank += entry_at(i).live;
+      compact();
+      return {this, rank};
+    }
+    return {this, next_live(std::min(index, count_))};
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  typename FLAT_HASH_MAP::value_type FLAT_HASH_MAP::pop_back()
+  {
+    value_type kv = std::move(entry_at(count_ - 1).kv);
+    erase_index(count_ - 1);
+    drop_trailing_holes();
+    return kv;
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::clear()
+  {
+    chunks_.clear();
+    count_ = size_ = holes_ = 0;
+    if (!slots_.empty())
+      rehash(capacity());
+  }
+
+  FLAT_HASH_MAP_TEMPLATE
+  void FLAT_HASH_MAP::reserve(size_type count)
+  {
+    size_type capacity = std::max(min_capacity, this->capacity());
+    while (count > max_load(capacity))
+      capacity *= 2;
+    if (capacity != this->capacity())
+      rehash(capacity);
+  }
+
+#undef FLAT_HASH_MAP
+#undef FLAT_HASH_MAP_TEMPLATE
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,233 @@
+#ifndef PYTHONIC_UTILS_GEMM_HPP
+#define PYTHONIC_UTILS_GEMM_HPP
+
+#include "pythonic/include/utils/gemm.hpp"
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  template <class T>
+  T const &matrix_view<T>::operator()(long i, long j) const
+  {
+    return data[i * row_stride + j * col_stride];
+  }
+
+  template <class T>
+  matrix_view<T> matrix_view<T>::transpose() const
+  {
+    return {data, col_stride, row_stride};
+  }
+
+  template <class T>
+  T const &vector_view<T>::operator[](long i) const
+  {
+    return data[i * stride];
+  }
+
+  namespace details
+  {
+    // Blocking factors: a kc x nr sliver of b stays in L1 while the packed
+    // mc x kc block of a stays in L2 and the kc x nc panel of b in L3.
+    static constexpr long gemm_kc = 256;
+    static constexpr long gemm_mc = 96;
+    static constexpr long gemm_nc = 1024;
+
+    /* Multiply an mr x kc sliver of a, stored column by column, with a kc x
+     * nr sliver of b, stored row by row, into the row major mr x nr tile.
+     */
+    template <class T, class Enable = void>
+    struct gemm_kernel {
+      static constexpr long mr = 4;
+      static constexpr long nr = 8;
+
+      static void run(long kc, T const *a, T const *b, T *tile)
+      {
+        T acc[mr][nr] = {};
+        for (long p = 0; p < kc; ++p, a += mr, b += nr)
+          for (long i = 0; i < mr; ++i)
+            for (long j = 0; j < nr; ++j)
+              acc[i][j] += a[i] * b[j];
+        for (long i = 0; i < mr; ++i)
+          std::copy(acc[i], acc[i] + nr, tile + i * nr);
+      }
+    };
+
+#ifdef USE_XSIMD
+    template <class T>
+    struct gemm_kernel<
+        T, typename std::enable_if<std::is_same<T, float>::value ||
+                                   std::is_same<T, double>::value>::type> {
+      using batch_type = xsimd::simd_type<T>;
+      static constexpr long width = batch_type::size;
+      // 12 accumulators, which leaves room for the operands in 16 registers
+      static constexpr long mr = 6;
+      static constexpr long nr = 2 * width;
+
+      static void run(long kc, T const *a, T const *b, T *tile)
+      {
+        batch_type acc[mr][2];
+        for (long i = 0; i < mr; ++i)
+          acc[i][0] = acc[i][1] = batch_type(T(0));
+        for (long p = 0; p < kc; ++p, a += mr, b += nr) {
+          batch_type b0 = xsimd::load_unaligned(b);
+          batch_type b1 = xsimd::load_unaligned(b + width);
+          for (long i = 0; i < mr; ++i) {
+            batch_type ai(a[i]);
+            acc[i][0] = xsimd::fma(ai, b0, acc[i][0]);
+            acc[i][1] = xsimd::fma(ai, b1, acc[i][1]);
+          }
+        }
+        for (long i = 0; i < mr; ++i) {
+          acc[i][0].store_unaligned(tile + i * nr);
+          acc[i][1].store_unaligned(tile + i * nr + width);
+        }
+      }
+    };
+#endif
+
+    // Pack rows [0, mc) and columns [0, kc) of a into mr-row slivers, zero
+    // padding the last one.
+    template <long mr, class T, class TA>
+    void gemm_pack_a(matrix_view<TA> a, long mc, long kc, T *out)
+    {
+      for (long ir = 0; ir < mc; ir += mr) {
+        long rows = std::min(mr, mc - ir);
+        for (long p = 0; p < kc; ++p) {
+          for (long i = 0; i < rows; ++i)
+            out[i] = a(ir + i, p);
+          std::fill(out + rows, out + mr, T(0));
+          out += mr;
+        }
+      }
+    }
+
+    // Pack rows [0, kc) and columns [0, nc) of b into nr-column slivers,
+    // zero padding the last one.
+    template <long nr, class T, class TB>
+    void gemm_pack_b(matrix_view<TB> b, long kc, long nc, T *out)
+    {
+      for (long jr = 0; jr < nc; jr += nr) {
+        long cols = std::min(nr, nc - jr);
+        for (long p = 0; p < kc; ++p) {
+          for (long j = 0; j < cols; ++j)
+            out[j] = b(p, jr + j);
+          std::fill(out + cols, out + nr, T(0));
+          out += nr;
+        }
+      }
+    }
+
+    template <class T>
+    void gemm_update(T *out, long ldo, T const *tile, long nr, long rows,
+                     long cols, bool first)
+    {
+      for (long i = 0; i < rows; ++i, out += ldo, tile += nr)
+        if (first)
+          std::copy(tile, tile + cols, out);
+        else
+          for (long j = 0; j < cols; ++j)
+            out[j] += tile[j];
+    }
+
+    inline long gemm_round_up(long value, long multiple)
+    {
+      return (value + multiple - 1) / multiple * multiple;
+    }
+  }
+
+  template <class T, class TA, class TB>
+  void gemm(long m, long n, long k, matrix_view<TA> a, matrix_view<TB> b,
+            T *out)
+  {
+    using kernel = details::gemm_kernel<T>;
+    constexpr long mr = kernel::mr;
+    constexpr long nr = kernel::nr;
+
+    if (k == 0) {
+      std::fill(out, out + m * n, T(0));
+      return;
+    }
+
+    long mc_max = std::min(details::gemm_mc, m);
+    long kc_max = std::min(details::gemm_kc, k);
+    long nc_max = std::min(details::gemm_nc, n);
+    std::vector<T> packed_a(details::gemm_round_up(mc_max, mr) * kc_max);
+    std::vector<T> packed_b(details::gemm_round_up(nc_max, nr) * kc_max);
+    T tile[mr * nr];
+
+    for (long jc = 0; jc < n; jc += nc_max) {
+      long nc = std::min(nc_max, n - jc);
+      for (long pc = 0; pc < k; pc += kc_max) {
+        long kc = std::min(kc_max, k - pc);
+        details::gemm_pack_b<nr>(
+            matrix_view<TB>{&b(pc, jc), b.row_stride, b.col_stride}, kc, nc,
+            packed_b.data());
+        for (long ic = 0; ic < m; ic += mc_max) {
+          long mc = std::min(mc_max, m - ic);
+          details::gemm_pack_a<mr>(
+              matrix_view<TA>{&a(ic, pc), a.row_stride, a.col_stride}, mc, kc,
+              packed_a.data());
+          for (long jr = 0; jr < nc; jr += nr)
+            for (long ir = 0; ir < mc; ir += mr) {
+              kernel::run(kc, packed_a.data() + ir * kc,
+                          packed_b.data() + jr * kc, tile);
+              details::gemm_update(out + (ic + ir) * n + jc + jr, n, tile, nr,
+                                   std::min(mr, mc - ir), std::min(nr, nc - jr),
+                                   pc == 0);
+            }
+        }
+      }
+    }
+  }
+
+  template <class T, class TA, class TX>
+  void gemv(long m, long n, matrix_view<TA> a, vector_view<TX> x, T *out)
+  {
+    constexpr long rows = 4;
+    // independent partial sums per row, so that the reduction vectorizes
+    // without reassociating floating point additions
+    constexpr long lanes = 8;
+
+    if (a.col_stride == 1) {
+      // contiguous rows: a few dot products at once
+      long i = 0;
+      for (; i < m; i += rows) {
+        long nrows = std::min(rows, m - i);
+        T acc[rows][lanes] = {};
+        long j = 0;
+        for (; j + lanes <= n; j += lanes)
+          for (long r = 0; r < nrows; ++r) {
+            TA const *row = &a(i + r, j);
+            for (long l = 0; l < lanes; ++l)
+              acc[r][l] += T(row[l]) * T(x[j + l]);
+          }
+        for (long r = 0; r < nrows; ++r) {
+          T res = T(0);
+          for (long l = 0; l < lanes; ++l)
+            res += acc[r][l];
+          for (long jj = j; jj < n; ++jj)
+            res += T(a(i + r, jj)) * T(x[jj]);
+          out[i + r] = res;
+        }
+      }
+    } else {
+      // otherwise, accumulate columns scaled by the matching element of x,
+      // which streams through a whenever its columns are contiguous
+      std::fill(out, out + m, T(0));
+      for (long j = 0; j < n; ++j) {
+        T xj = x[j];
+        TA const *col = &a(0, j);
+        for (long i = 0; i < m; ++i)
+          out[i] += T(col[i * a.row_stride]) * xj;
+      }
+    }
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -0,0 +1,32 @@
+#ifndef PYTHONIC_UTILS_PARALLEL_REDUCE_HPP
+#define PYTHONIC_UTILS_PARALLEL_REDUCE_HPP
+
+#include "pythonic/include/utils/parallel_reduce.hpp"
+
+#include <algorithm>
+#include <memory>
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  template <class T, class Chunk, class Combine>
+  T parallel_reduce(long n, long block, Chunk chunk, Combine combine)
+  {
+    long nblocks = std::max(1L, (n + block - 1) / block);
+    // ! a std::vector, which would pack booleans
+    std::unique_ptr<T[]> partials(new T[nblocks]);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (nblocks > 1)
+#endif
+    for (long b = 0; b < nblocks; ++b)
+      partials[b] = chunk(b * block, std::min(n, (b + 1) * block));
+    for (long step = 1; step < nblocks; step *= 2)
+      for (long b = 0; b + step < nblocks; b += 2 * step)
+        combine(partials[b], partials[b + step]);
+    return partials[0];
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -95,6 +95,18 @@ namespace utils
     return &mem->ptr;
   }
 
+  template <class T>
+  shared_ref<T>::operator bool() const noexcept
+  {
+    return mem != nullptr;
+  }
+
+  template <class T>
+  bool shared_ref<T>::unique() const noexcept
+  {
+    return mem->count == 1;
+  }
+
   template <class T>
   bool shared_ref<T>::operator!=(shared_ref<T> const &other) const noexcept
   {
@@ -0,0 +1,466 @@
+#ifndef PYTHONIC_UTILS_SORT_HPP
+#define PYTHONIC_UTILS_SORT_HPP
+
+#include "pythonic/include/utils/sort.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <memory>
+
+#ifdef USE_XSIMD
+#include <xsimd/xsimd.hpp>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+
+// as a macro so that an enlightened user can modify this variable :-)
+#ifndef PYTHRAN_OPENMP_MIN_ITERATION_COUNT
+#define PYTHRAN_OPENMP_MIN_ITERATION_COUNT 1000
+#endif
+
+#endif
+
+PYTHONIC_NS_BEGIN
+
+namespace utils
+{
+  template <class T>
+  bool sort_less<T>::operator()(T const &i, T const &j) const
+  {
+    return i < j || (j != j && i == i);
+  }
+
+  template <class T>
+  bool sort_less<std::complex<T>>::
+  operator()(std::complex<T> const &i, std::complex<T> const &j) const
+  {
+    if (std::real(i) == std::real(j))
+      return std::imag(i) < std::imag(j);
+    else
+      return std::real(i) < std::real(j);
+  }
+
+  template <class T>
+  bool argsort_less<T>::operator()(std::pair<T, long> const &i,
+                                   std::pair<T, long> const &j) const
+  {
+    sort_less<T> less;
+    return less(i.first, j.first) ||
+           (!less(j.first, i.first) && i.second < j.second);
+  }
+
+  /// radix keys
+
+  radix_key<bool>::type radix_key<bool>::get(bool x)
+  {
+    return x;
+  }
+
+  template <class T>
+  typename radix_key<T, typename std::enable_if<
+                            std::is_integral<T>::value &&
+                            !std::is_same<T, bool>::value>::type>::type
+  radix_key<T, typename std::enable_if<
+                   std::is_integral<T>::value &&
+                   !std::is_same<T, bool>::value>::type>::get(T x)
+  {
+    // flipping the sign bit moves negative values below positive ones
+    return type(x) ^ (std::is_signed<T>::value
+                          ? type(type(1) << (8 * sizeof(T) - 1))
+                          : type(0));
+  }
+
+  namespace details
+  {
+    template <class K, class T>
+    K float_key(T x)
+    {
+      if (x != x)
+        return ~K(0);
+      // -0. && 0. compare equal
+      if (x == 0)
+        x = 0;
+      K bits;
+      std::memcpy(&bits, &x, sizeof(bits));
+      constexpr K sign = K(1) << (8 * sizeof(K) - 1);
+      // negative values are ordered backward by their bits
+      return (bits & sign) ? ~bits : (bits | sign);
+    }
+  }
+
+  radix_key<float>::type radix_key<float>::get(float x)
+  {
+    return details::float_key<type>(x);
+  }
+
+  radix_key<double>::type radix_key<double>::get(double x)
+  {
+    return details::float_key<type>(x);
+  }
+
+  /// radix sorts
+
+  namespace details
+  {
+    /* Sort first[0:n] by key(item), using scratch[0:n] as the target of one
+     * pass out of two. The counts of all the passes are computed at once.
+     */
+    template <class Item, class Key>
+    void radix_passes(Item *first, Item *scratch, long n, Key key)
+    {
+      using key_type = decltype(key(*first));
+      constexpr size_t passes = sizeof(key_type);
+      if (n < 2)
+        return;
+      long counts[passes][256] = {};
+      for (long i = 0; i < n; ++i) {
+        key_type k = key(first[i]);
+        for (size_t p = 0; p < passes; ++p)
+          ++counts[p][(k >> (8 * p)) & 0xFF];
+      }
+      Item *src = first, *dst = scratch;
+      for (size_t p = 0; p < passes; ++p) {
+        long *count = counts[p];
+        if (count[(key(*src) >> (8 * p)) & 0xFF] == n)
+          continue;
+        for (long d = 0, offset = 0; d < 256; ++d) {
+          long c = count[d];
+          count[d] = offset;
+          offset += c;
+        }
+        for (long i = 0; i < n; ++i) {
+          Item const &item = src[i];
+          dst[count[(key(item) >> (8 * p)) & 0xFF]++] = item;
+        }
+        std::swap(src, dst);
+      }
+      if (src != first)
+        std::copy(src, src + n, first);
+    }
+
+    template <class T>
+    struct value_key {
+      typename radix_key<T>::type operator()(T const &x) const
+      {
+        return radix_key<T>::get(x);
+      }
+    };
+
+    template <class K>
+    struct pair_key {
+      K operator()(std::pair<K, long> const &x) const
+      {
+        return x.first;
+      }
+    };
+  }
+
+  template <class T>
+  void radix_sort(T *first, T *last)
+  {
+    long n = last - first;
+    std::unique_ptr<T[]> scratch(new T[n]);
+    details::radix_passes(first, scratch.get(), n, details::value_key<T>{});
+  }
+
+  template <class T>
+  void radix_argsort(T const *values, long *indices, long n)
+  {
+    using key_type = typename radix_key<T>::type;
+    using item_type = std::pair<key_type, long>;
+    std::unique_ptr<item_type[]> items(new item_type[2 * n]);
+    for (long i = 0; i < n; ++i)
+      items[i] = item_type(radix_key<T>::get(values[i]), i);
+    details::radix_passes(items.get(), items.get() + n, n,
+                          details::pair_key<key_type>{});
+    for (long i = 0; i < n; ++i)
+      indices[i] = items[i].second;
+  }
+
+  /// sorting networks
+
+  template <class F>
+  void merge_exchange(long n, F compare_exchange)
+  {
+    if (n < 2)
+      return;
+    long t = 1;
+    while ((1L << t) < n)
+      ++t;
+    for (long p = 1L << (t - 1); p > 0; p >>= 1) {
+      long q = 1L << (t - 1), r = 0, d = p;
+      while (true) {
+        for (long i = 0; i < n - d; ++i)
+          if ((i & p) == r)
+            compare_exchange(i, i + d);
+        if (q == p)
+          break;
+        d = q - p;
+        q >>= 1;
+        r = p;
+      }
+    }
+  }
+
+  namespace details
+  {
+    // branchless, so that it compiles to conditional moves
+    template <class T, class Less>
+    void compare_exchange(T &a, T &b, Less less)
+    {
+      bool swap = less(b, a);
+      T lo = swap ? b : a;
+      T hi = swap ? a : b;
+      a = lo;
+      b = hi;
+    }
+
+    template <class T, bool vectorize>
+    struct network_columns {
+      void operator()(T *ri, T *rj, long width) const
+      {
+        for (long l = 0; l < width; ++l)
+          compare_exchange(ri[l], rj[l], sort_less<T>{});
+      }
+    };
+
+#ifdef USE_XSIMD
+    template <class T>
+    struct network_columns<T, true> {
+      void operator()(T *ri, T *rj, long width) const
+      {
+        using batch_type = xsimd::simd_type<T>;
+        constexpr long N = batch_type::size;
+        long l = 0;
+        for (; l + N <= width; l += N) {
+          batch_type a = xsimd::load_unaligned(ri + l);
+          batch_type b = xsimd::load_unaligned(rj + l);
+          // same as sort_less<T>{}(b, a), but != is ordered in some kernels
+          auto swap = (b == b) && ~(a <= b);
+          xsimd::select(swap, b, a).store_unaligned(ri + l);
+          xsimd::select(swap, a, b).store_unaligned(rj + l);
+        }
+        network_columns<T, false>{}(ri + l, rj + l, width - l);
+      }
+    };
+#endif
+  }
+
+#ifdef USE_XSIMD
+  // the blend of small integers && the comparison of unsigned ones are !
+  // reliable across instruction sets
+  template <class T>
+  using network_vectorized = std::integral_constant<
+      bool, std::is_arithmetic<T>::value && std::is_signed<T>::value &&
+                (sizeof(T) >= 4) && (xsimd::simd_traits<T>::size > 1)>;
+#else
+  template <class T>
+  using network_vectorized = std::false_type;
+#endif
+
+  template <class T>
+  void network_sort(T *tile, long n, long width, long ld)
+  {
+    details::network_columns<T, network_vectorized<T>::value> columns;
+    merge_exchange(n, [tile, width, ld, columns](long i, long j) {
+      columns(tile + i * ld, tile + j * ld, width);
+    });
+  }
+
+  /// insertion sorts
+
+  template <class T>
+  void insertion_sort(T *first, T *last)
+  {
+    sort_less<T> less;
+    for (T *curr = first + 1; curr < last; ++curr) {
+      T value = *curr;
+      T *hole = curr;
+      for (; hole != first && less(value, hole[-1]); --hole)
+        *hole = hole[-1];
+      *hole = value;
+    }
+  }
+
+  template <class T>
+  void insertion_argsort(T const *values, long *indices, long n)
+  {
+    std::pair<T, long> items[PYTHRAN_SHORT_SORT_SIZE];
+    for (long i = 0; i < n; ++i)
+      items[i] = std::pair<T, long>(values[i], i);
+    sort_less<T> less;
+    for (long i = 1; i < n; ++i) {
+      std::pair<T, long> item = items[i];
+      long j = i;
+      for (; j > 0 && less(item.first, items[j - 1].first); --j)
+        items[j] = items[j - 1];
+      items[j] = item;
+    }
+    for (long i = 0; i < n; ++i)
+      indices[i] = items[i].second;
+  }
+
+  /// selection
+
+  namespace details
+  {
+    // restore the max-heap first[0:n] after its root has been replaced
+    template <class I, class Less>
+    void sift_down(I first, long n, Less less)
+    {
+      auto value = std::move(first[0]);
+      long hole = 0;
+      for (long child = 1; child < n; child = 2 * hole + 1) {
+        if (child + 1 < n && less(first[child], first[child + 1]))
+          ++child;
+        if (!less(value, first[child]))
+          break;
+        first[hole] = std::move(first[child]);
+        hole = child;
+      }
+      first[hole] = std::move(value);
+    }
+
+    /* Keep the smallest elements in [first, nth] as a max-heap. Gives up,
+     * leaving a permutation of the range, when too many elements reach the
+     * heap, as for reverse sorted input.
+     */
+    template <class I, class Less>
+    bool heap_select(I first, I nth, I last, Less less)
+    {
+      I end = nth + 1;
+      long budget = (last - first) / 8;
+      std::make_heap(first, end, less);
+      for (I curr = end; curr != last; ++curr)
+        if (less(*curr, *first)) {
+          if (--budget < 0)
+            return false;
+          std::iter_swap(first, curr);
+          sift_down(first, end - first, less);
+        }
+      std::pop_heap(first, end, less);
+      return true;
+    }
+
+    template <class Less>
+    struct reversed_less {
+      Less less;
+      template <class T>
+      bool operator()(T const &i, T const &j) const
+      {
+        return less(j, i);
+      }
+    };
+  }
+
+  template <class T, class Less>
+  void nth_element(T *first, T *nth, T *last, Less less)
+  {
+    long const n = last - first;
+    long const k = nth - first;
+    // the heap gets expensive when most of the elements reach it
+    long const top = std::min<long>(PYTHRAN_TOP_K_SIZE, n / 64);
+    if (k < top) {
+      if (details::heap_select(first, nth, last, less))
+        return;
+    } else if (k < n && n - k <= top) {
+      // the largest elements, as the smallest ones of the reversed range
+      using iterator = std::reverse_iterator<T *>;
+      if (details::heap_select(iterator(last), iterator(nth + 1),
+                               iterator(first),
+                               details::reversed_less<Less>{less}))
+        return;
+    }
+    std::nth_element(first, nth, last, less);
+  }
+
+  /// axis sorting engine
+
+  bool parallel_lanes(long size, long tasks)
+  {
+#ifdef _OPENMP
+    return size >= PYTHRAN_OPENMP_MIN_ITERATION_COUNT && tasks > 1 &&
+           !omp_in_parallel();
+#else
+    return false;
+#endif
+  }
+
+  template <class T>
+  void gather_tile(T *lanes, T const *tile, long n, long ld, long width)
+  {
+    for (long k = 0; k < n; ++k)
+      for (long l = 0; l < width; ++l)
+        lanes[l * n + k] = tile[k * ld + l];
+  }
+
+  template <class T>
+  void scatter_tile(T *tile, T const *lanes, long n, long ld, long width)
+  {
+    for (long k = 0; k < n; ++k)
+      for (long l = 0; l < width; ++l)
+        tile[k * ld + l] = lanes[l * n + k];
+  }
+
+  template <class T, class Kernel>
+  void sort_lanes(T *data, long outer, long n, long inner,
+                  Kernel const &kernel)
+  {
+    long const size = outer * n * inner;
+    if (inner == 1) {
+#pragma omp parallel for if (parallel_lanes(size, outer))
+      for (long o = 0; o < outer; ++o)
+        kernel(data + o * n, n);
+      return;
+    }
+    long const tiles = (inner + PYTHRAN_SORT_TILE - 1) / PYTHRAN_SORT_TILE;
+#pragma omp parallel if (parallel_lanes(size, outer * tiles))
+    {
+      std::unique_ptr<T[]> lanes(new T[PYTHRAN_SORT_TILE * n]);
+#pragma omp for
+      for (long t = 0; t < outer * tiles; ++t) {
+        long const i = t % tiles * PYTHRAN_SORT_TILE;
+        long const width = std::min<long>(PYTHRAN_SORT_TILE, inner - i);
+        T *tile = data + t / tiles * n * inner + i;
+        gather_tile(lanes.get(), tile, n, inner, width);
+        for (long l = 0; l < width; ++l)
+          kernel(lanes.get() + l * n, n);
+        scatter_tile(tile, lanes.get(), n, inner, width);
+      }
+    }
+  }
+
+  template <class T, class U, class Kernel>
+  void map_lanes(T const *in, U *out, long outer, long n, long inner,
+                 Kernel const &kernel)
+  {
+    long const size = outer * n * inner;
+    if (inner == 1) {
+#pragma omp parallel for if (parallel_lanes(size, outer))
+      for (long o = 0; o < outer; ++o)
+        kernel(in + o * n, out + o * n, n);
+      return;
+    }
+    long const tiles = (inner + PYTHRAN_SORT_TILE - 1) / PYTHRAN_SORT_TILE;
+#pragma omp parallel if (parallel_lanes(size, outer * tiles))
+    {
+      std::unique_ptr<T[]> lanes(new T[PYTHRAN_SORT_TILE * n]);
+      std::unique_ptr<U[]> results(new U[PYTHRAN_SORT_TILE * n]);
+#pragma omp for
+      for (long t = 0; t < outer * tiles; ++t) {
+        long const i = t % tiles * PYTHRAN_SORT_TILE;
+        long const width = std::min<long>(PYTHRAN_SORT_TILE, inner - i);
+        long const offset = t / tiles * n * inner + i;
+        gather_tile(lanes.get(), in + offset, n, inner, width);
+        for (long l = 0; l < width; ++l)
+          kernel(lanes.get() + l * n, results.get() + l * n, n);
+        scatter_tile(out + offset, results.get(), n, inner, width);
+      }
+    }
+  }
+}
+PYTHONIC_NS_END
+
+#endif
@@ -8,6 +8,8 @@ import os
 import sys
 
 import pythran
+import pythran.cache
+from pythran.time_report import TimeReport
 
 from distutils.errors import CompileError
 
@@ -39,11 +41,14 @@ def compile_flags(args):
         'extra_link_args': args.extra_flags,
         'config': args.config,
     }
-    for param in ('opts', ):
+    for param in ('opts', 'split'):
         val = getattr(args, param, None)
         if val:
             compiler_options[param] = val
 
+    if getattr(args, 'report', None) is not None:
+        compiler_options['time_report'] = args.report
+
     return compiler_options
 
 
@@ -60,7 +65,7 @@ def run():
                                      prefix_chars=prefix_chars,
                                      fromfile_prefix_chars="@")
 
-    parser.add_argument('input_file', type=str,
+    parser.add_argument('input_file', type=str, nargs='?',
                         help='the pythran module to compile, '
                              'either a .py or a .cpp file')
 
@@ -122,6 +127,29 @@ def run():
                         help='config additional params',
                         default=list())
 
+    parser.add_argument('--cache-info', dest='cache_info',
+                        action='store_true',
+                        help='print the location and size of the compilation '
+                        'cache')
+
+    parser.add_argument('--cache-clear', dest='cache_clear',
+                        action='store_true',
+                        help='remove every module from the compilation cache')
+
+    parser.add_argument('--split', dest='split', metavar='count', type=int,
+                        help='compile the exported functions in up to count '
+                        'translation units, built concurrently')
+
+    parser.add_argument('--time-report', dest='time_report',
+                        action='store_true',
+                        help='print the time spent in each compilation '
+                        'phase and pass, bypassing the compilation cache')
+
+    parser.add_argument('--time-trace', dest='time_trace',
+                        action='store_true',
+                        help='like --time-report, and also list the most '
+                        'expensive pythonic templates (requires clang)')
+
     parser.convert_arg_line_to_args = convert_arg_line_to_args
 
     args, extra = parser.parse_known_args(sys.argv[1:])
@@ -144,6 +172,20 @@ def run():
     if args.verbose and not args.warn_off:
         pythran.config.lint_cfg(pythran.config.cfg)
 
+    if args.time_report or args.time_trace:
+        args.report = TimeReport(trace=args.time_trace)
+    else:
+        args.report = None
+
+    if args.cache_clear:
+        pythran.cache.clear(args.config)
+    if args.cache_info:
+        print(pythran.cache.info(args.config))
+    if args.input_file is None:
+        if args.cache_clear or args.cache_info:
+            return
+        parser.error("the following arguments are required: input_file")
+
     try:
         if not os.path.exists(args.input_file):
             raise ValueError("input file `{0}' not found".format(
@@ -176,6 +218,9 @@ def run():
                                         pyonly=args.optimize_only,
                                         **compile_flags(args))
 
+        if args.report is not None:
+            print(args.report)
+
     except IOError as e:
         logger.critical("I've got a bad feeling about this...\n"
                         "E: " + str(e))
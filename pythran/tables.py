@@ -244,6 +244,9 @@ CLASSES = {
         "isdigit": ConstMethodIntr(signature=Fun[[str], bool]),
         "join": ConstMethodIntr(signature=Fun[[str, Iterable[str]], str]),
         "lower": ConstMethodIntr(signature=Fun[[str], str]),
+        "partition": ConstMethodIntr(
+            signature=Fun[[str, str], Tuple[str, str, str]]
+        ),
         "replace": ConstMethodIntr(
             signature=Union[
                 Fun[[str, str, str], str],
@@ -838,6 +841,9 @@ CLASSES = {
                 Fun[[NDArray[complex, :, :, :, :]], List[complex]],
             ]
         ),
+        "tofile": ConstMethodIntr(args=("self", "fid", "sep", "format"),
+                                  defaults=("", "%s"),
+                                  global_effects=True),
         "tostring": ConstMethodIntr(signature=Fun[[NDArray[T0, :]], str]),
     },
 }
@@ -1286,6 +1292,17 @@ _numpy_unary_op_int_axis_signature = Union[
         NDArray[int, :, :, :]],
 ]
 
+_numpy_argsort_signature = Union[
+    tuple(Fun[[iterable] + extra, NDArray[(int,) + (slice(0),) * depth]]
+          for dtype in (bool, int, float, complex)
+          for depth, iterable in enumerate(
+              (Iterable[dtype],
+               Iterable[Iterable[dtype]],
+               Iterable[Iterable[Iterable[dtype]]],
+               Iterable[Iterable[Iterable[Iterable[dtype]]]]), 1)
+          for extra in ([], [int], [int, str]))
+]
+
 _numpy_unary_op_sum_axis_signature = Union[
     # no axis
     # 1d
@@ -3196,8 +3213,11 @@ MODULES = {
             signature=_numpy_unary_op_int_axis_signature,
             return_range=interval.positive_values
         ),
+        "argpartition": ConstMethodIntr(
+            return_range=interval.positive_values
+        ),
         "argsort": ConstMethodIntr(
-            signature=_numpy_unary_op_int_axis_signature,
+            signature=_numpy_argsort_signature,
             return_range=interval.positive_values
         ),
         "argwhere": ConstFunctionIntr(
@@ -3709,7 +3729,8 @@ MODULES = {
         "diff": ConstFunctionIntr(),
         "digitize": ConstFunctionIntr(),
         "divide": UFunc(BINARY_UFUNC),
-        "dot": ConstMethodIntr(),
+        "dot": MethodIntr(
+            argument_effects=[ReadEffect(), ReadEffect(), UpdateEffect()]),
         "double": ConstFunctionIntr(signature=_float_signature),
         "dtype": ClassWithConstConstructor(CLASSES["dtype"]),
         "e": ConstantIntr(),
@@ -3753,6 +3774,13 @@ MODULES = {
         "fmin": UFunc(BINARY_UFUNC),
         "fmod": UFunc(BINARY_UFUNC),
         "frexp": ConstFunctionIntr(),
+        "frombuffer": ConstFunctionIntr(
+            args=("buffer", "dtype", "count", "offset"),
+            defaults=(-1, 0)),
+        "fromfile": FunctionIntr(
+            args=("file", "dtype", "count", "sep", "offset"),
+            defaults=(-1, "", 0),
+            global_effects=True),
         "fromfunction": ConstFunctionIntr(),
         "fromiter": ConstFunctionIntr(args=("iterable", "dtype", "count"),
                                       defaults=(-1,)),
@@ -3844,6 +3872,10 @@ MODULES = {
         "median": ConstFunctionIntr(
             signature=_numpy_unary_op_sum_axis_signature
         ),
+        "memmap": FunctionIntr(
+            args=("filename", "dtype", "mode", "offset", "shape"),
+            defaults=("r+", 0, None),
+            global_effects=True),
         "min": ConstMethodIntr(signature=_numpy_unary_op_axis_signature),
         "minimum": UFunc(
             BINARY_UFUNC,
@@ -3859,6 +3891,7 @@ MODULES = {
         "nanargmax": ConstFunctionIntr(),
         "nanargmin": ConstFunctionIntr(),
         "nanmax": ConstFunctionIntr(),
+        "nanmedian": ConstFunctionIntr(),
         "nanmin": ConstFunctionIntr(),
         "nansum": ConstFunctionIntr(),
         "ndenumerate": ConstFunctionIntr(),
@@ -3874,6 +3907,8 @@ MODULES = {
         "ones": ConstFunctionIntr(signature=_numpy_ones_signature),
         "ones_like": ConstFunctionIntr(signature=_numpy_ones_like_signature),
         "outer": ConstFunctionIntr(),
+        "partition": ConstFunctionIntr(),
+        "percentile": ConstFunctionIntr(),
         "pi": ConstantIntr(),
         "place": FunctionIntr(),
         "power": UFunc(
@@ -3885,6 +3920,7 @@ MODULES = {
         "ptp": ConstMethodIntr(),
         "put": MethodIntr(),
         "putmask": FunctionIntr(),
+        "quantile": ConstFunctionIntr(),
         "rad2deg": ConstFunctionIntr(
             signature=_numpy_float_unary_op_float_signature
         ),
@@ -4620,6 +4656,10 @@ def save_arguments(module_name, elements):
                 obj = getattr(themodule, elem)
                 while hasattr(obj, '__wrapped__'):
                     obj = obj.__wrapped__
+                # the argspec of a class starts with its instance, e.g.
+                # numpy.memmap, so keep pythran's own description if any
+                if isinstance(obj, type) and signature.args.args:
+                    continue
                 spec = getfullargspec(obj)
                 if signature.args.args:
                     logger.warn(
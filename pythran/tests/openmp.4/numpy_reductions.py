@@ -0,0 +1,18 @@
+import numpy as np
+
+def numpy_reductions():
+    n = 300000
+    a = np.arange(n)
+    b = a.reshape(600, 500)
+    c = (a % 7).reshape(3, 100000)
+    ok = np.sum(a) == n * (n - 1) // 2
+    ok &= np.sum(b[1:, ::2]) == np.sum(b) - np.sum(b[0]) - np.sum(b[1:, 1::2])
+    ok &= np.max(a * 3 - 1) == 3 * n - 4 and np.min(-a) == 1 - n
+    ok &= np.argmax(a % 1000) == 999 and np.argmin(b.T) == 0
+    ok &= np.argmax(c) == 6 and np.argmin(-c) == 6
+    ok &= np.all(a >= 0) and not np.any(a < 0) and np.any(a == n - 1)
+    ok &= np.mean(a) == (n - 1) / 2.
+    ok &= np.all(np.sum(b, 0) == np.arange(500) * 600 + 500 * 600 * 599 // 2)
+    ok &= np.all(np.max(b, 1) == np.arange(600) * 500 + 499)
+    ok &= np.all(np.sum(c, 1) == [np.sum(c[0]), np.sum(c[1]), np.sum(c[2])])
+    return ok
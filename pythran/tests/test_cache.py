@@ -0,0 +1,126 @@
+""" Tests for the persistent compilation cache. """
+
+from pythran import cache
+from pythran.config import cfg
+
+import os
+import shutil
+import tempfile
+import unittest
+
+
+class TestCache(unittest.TestCase):
+
+    code = "def foo(a): return a + 1"
+
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+        self.config = ['cache.directory=' + self.directory,
+                       'cache.max_size=1']
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def key(self, code=None, specs=None, module_name='foo'):
+        return cache.make_key(module_name, code or self.code,
+                              specs or {'foo': [int]}, [], None, {})
+
+    def write(self, relpath, size=1, age=0):
+        path = os.path.join(self.directory, relpath)
+        if not os.path.isdir(os.path.dirname(path)):
+            os.makedirs(os.path.dirname(path))
+        with open(path, 'wb') as out:
+            out.write(b'x' * size)
+        # older files are evicted first
+        os.utime(path, (1e9 - age, 1e9 - age))
+        return path
+
+    def test_key_is_stable(self):
+        self.assertEqual(self.key(), self.key())
+
+    def test_key_depends_on_code(self):
+        self.assertNotEqual(self.key(), self.key(code=self.code + " * 2"))
+        self.assertNotEqual(self.key(), self.key(specs={'foo': [float]}))
+        self.assertNotEqual(self.key(), self.key(module_name='bar'))
+
+    def test_key_depends_on_environment(self):
+        key = self.key()
+        previous = os.environ.get('CXXFLAGS')
+        os.environ['CXXFLAGS'] = '-O0 -DPYTHRAN_TEST_CACHE'
+        try:
+            self.assertNotEqual(key, self.key())
+        finally:
+            if previous is None:
+                del os.environ['CXXFLAGS']
+            else:
+                os.environ['CXXFLAGS'] = previous
+        self.assertEqual(key, self.key())
+
+    def test_key_depends_on_pythran_options(self):
+        key = self.key()
+        previous = cfg.get('pythran', 'complex_hook')
+        cfg.set('pythran', 'complex_hook',
+                'False' if previous == 'True' else 'True')
+        try:
+            self.assertNotEqual(key, self.key())
+        finally:
+            cfg.set('pythran', 'complex_hook', previous)
+        self.assertEqual(key, self.key())
+
+    def test_store_lookup(self):
+        key = self.key()
+        self.assertIsNone(cache.lookup(key, self.config))
+        module = self.write('module.so', 10)
+        cache.store(key, module, self.config)
+        cached = cache.lookup(key, self.config)
+        self.assertEqual(cached, os.path.join(self.directory, key[:2], key))
+        with open(cached, 'rb') as fd:
+            self.assertEqual(fd.read(), b'x' * 10)
+
+    def test_evict_least_recently_used(self):
+        old = self.write(os.path.join('ab', 'ab' + '0' * 62), 600, age=2)
+        new = self.write(os.path.join('cd', 'cd' + '1' * 62), 600, age=1)
+        cache.evict(1000, self.directory)
+        self.assertFalse(os.path.exists(old))
+        self.assertTrue(os.path.exists(new))
+
+    def test_evict_keeps_foreign_files(self):
+        foreign = [self.write('notes.txt', 2000, age=3),
+                   self.write(os.path.join('ab', 'notes.txt'), 2000, age=3),
+                   # misplaced key
+                   self.write(os.path.join('ab', 'cd' + '0' * 62), 2000,
+                              age=3),
+                   self.write(os.path.join('pch', 'notes.txt'), 2000, age=3)]
+        entry = self.write(os.path.join('ef', 'ef' + '2' * 62), 10)
+        cache.evict(0, self.directory)
+        self.assertFalse(os.path.exists(entry))
+        for path in foreign:
+            self.assertTrue(os.path.exists(path), path)
+
+    def test_clear(self):
+        key = 'ab' + '3' * 62
+        entries = [self.write(os.path.join('ab', key)),
+                   self.write(os.path.join('ab', key + '.x1y2.tmp')),
+                   self.write(os.path.join('pch', key, cache.pch_header)),
+                   self.write(os.path.join('pch', key,
+                                           cache.pch_header + '.gch'))]
+        foreign = [self.write('notes.txt'),
+                   self.write(os.path.join('cd', 'notes.txt')),
+                   self.write(os.path.join('other', 'cd' + '4' * 62))]
+        cache.clear(self.config)
+        for path in entries:
+            self.assertFalse(os.path.exists(path), path)
+        for path in foreign:
+            self.assertTrue(os.path.exists(path), path)
+        self.assertEqual(sorted(os.listdir(self.directory)),
+                         ['cd', 'notes.txt', 'other'])
+
+    def test_info(self):
+        self.write(os.path.join('ab', 'ab' + '5' * 62), 2 ** 20)
+        self.write('notes.txt', 2 ** 20)
+        self.assertIn("1 entries, 1.0 MiB used out of 1 MiB",
+                      cache.info(self.config))
+
+
+if __name__ == '__main__':
+    unittest.main()
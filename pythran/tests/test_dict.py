@@ -1,4 +1,5 @@
 from pythran.tests import TestEnv
+from pythran.config import cfg
 from pythran.typing import Dict, List
 
 class TestDict(TestEnv):
@@ -95,6 +96,18 @@ def dict_copy(a):
             { 1: 2 },
             dict_popitem1=[Dict[int, int]])
 
+    def test_dict_popitem2(self):
+        return self.run_test(
+            "def dict_popitem2(n):\n a = {i * 7 % n: i for i in range(n)}\n a.pop(3)\n b = a.popitem()\n return b, list(a.keys())",
+            40,
+            dict_popitem2=[int])
+
+    def test_dict_insertion_order(self):
+        return self.run_test(
+            "def dict_insertion_order(n):\n a = {}\n for i in range(n): a[(i * 37) % n] = i\n for i in range(0, n, 3): a.pop(i * 37 % n)\n a[5] = 0\n return list(a.items())",
+            1000,
+            dict_insertion_order=[int])
+
     def test_dict_setdefault(self):
         return self.run_test("def dict_setdefault():\n a={1.5:2 }\n return a.setdefault(1.5) + a.setdefault(2, 18)", dict_setdefault=[])
 
@@ -135,3 +148,17 @@ def dict_copy(a):
                 return s""",
             {1:2,3:4},
             dict_iterate_item=[Dict[int, int]])
+
+    def test_borrowed_dict(self):
+        cfg.set('pythran', 'borrowed_arguments', 'True')
+        try:
+            self.run_test("""
+                def borrowed_dict(d):
+                    s = 0
+                    for k in d:
+                        s += len(k)
+                    return s + (d['a'] if 'a' in d else len(d))""",
+                {'a': 2, 'bc': 4},
+                borrowed_dict=[Dict[str, int]])
+        finally:
+            cfg.set('pythran', 'borrowed_arguments', 'False')
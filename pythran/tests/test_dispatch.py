@@ -0,0 +1,80 @@
+""" Tests for the selection of the overload of an exported function. """
+
+from imp import load_dynamic
+
+from pythran import compile_pythrancode
+from pythran.tests import TestEnv
+
+import numpy
+import os
+import unittest
+
+
+class TestDispatch(TestEnv):
+
+    # overloads declared last are tried first
+    code = '''
+#pythran export dispatch(int8)
+#pythran export dispatch(int)
+#pythran export dispatch(float)
+#pythran export dispatch(str)
+#pythran export dispatch(int, int)
+#pythran export dispatch(float, str)
+#pythran export dispatch(int list)
+def dispatch(a, b=2):
+    return a, b'''
+
+    def compile(self, modname, *flags):
+        module_path = compile_pythrancode(
+            modname, self.code,
+            extra_compile_args=self.PYTHRAN_CXX_FLAGS + list(flags))
+        try:
+            return load_dynamic(modname, module_path)
+        finally:
+            os.remove(module_path)
+
+    def check_dispatch(self, dispatch):
+        # the overload matched by the previous call is tried first, it must
+        # not win over an earlier overload once the argument types change
+        calls = [(1,), (1.5,), ('a',), ([1, 2],), (1,), (numpy.int8(3),),
+                 (4,), (numpy.int8(5),), (2.5,), (3, 4), (3.5, 'b'), (6,)]
+        for args in calls:
+            res = dispatch(*args)
+            self.assertEqual(res, (args + (2,))[:2])
+            self.assertEqual([type(r) for r in res],
+                             [type(r) for r in (args + (2,))[:2]])
+
+        # keyword arguments
+        self.assertEqual(dispatch(a=1), (1, 2))
+        self.assertEqual(dispatch(1, b=3), (1, 3))
+        self.assertEqual(dispatch(b=3, a=1), (1, 3))
+        self.assertEqual(dispatch(b='c', a=1.5), (1.5, 'c'))
+
+        # no overload matches
+        with self.assertRaises(TypeError) as error:
+            dispatch(1.5, 2)
+        self.assertIn("Invalid call to pythranized function "
+                      "`dispatch(float, int)'", str(error.exception))
+        self.assertIn("dispatch(float, str)", str(error.exception))
+        with self.assertRaises(TypeError) as error:
+            dispatch(1, b=1.5)
+        self.assertIn("`dispatch(int, b=float)'", str(error.exception))
+        invalid_calls = [((), {}), ((1, 2, 3), {}), ((), {'b': 3}),
+                         ((1,), {'a': 2}), ((1,), {'c': 2}), ((None,), {})]
+        for args, kwargs in invalid_calls:
+            with self.assertRaises(TypeError):
+                dispatch(*args, **kwargs)
+
+        # a failed call leaves the dispatcher usable
+        self.assertEqual(dispatch(1), (1, 2))
+
+    def test_dispatch(self):
+        self.check_dispatch(self.compile('test_dispatch').dispatch)
+
+    def test_dispatch_varargs(self):
+        self.check_dispatch(self.compile('test_dispatch_varargs',
+                                         '-DPYTHRAN_NO_FASTCALL').dispatch)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -125,6 +125,11 @@ def file_close(filename):
         self.tempfile()
         self.run_test("""def _iter(filename):\n f=open(filename)\n return [l for l in f]""", self.filename, _iter=[str])
 
+    def test_iter_long_lines(self):
+        self.file_content = "x" * 3000000 + "\n\nno trailing newline"
+        self.tempfile()
+        self.run_test("""def _iter_long_lines(filename):\n f=open(filename)\n l = f.readline(10)\n t = f.tell()\n lens = [len(l) for l in f]\n return l, t, lens""", self.filename, _iter_long_lines=[str])
+
     def test_fileno(self):
         self.tempfile()
         # Useless to check if same fileno, just checking if fct can be called
@@ -235,3 +240,7 @@ def file_close(filename):
     def test_xreadlines(self):
         self.tempfile()
         self.run_test("""def _xreadlines(filename):\n f= open(filename)\n return [l for l in f.xreadlines()]""", self.filename, _xreadlines=[str])
+
+    @unittest.skipIf(not sys.platform.startswith('linux'), "needs /proc")
+    def test_read_unknown_size(self):
+        self.run_test("def _read_unknown_size(filename): return len(open(filename).read().split())", "/proc/self/statm", _read_unknown_size=[str])
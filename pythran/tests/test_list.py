@@ -1,4 +1,5 @@
 from pythran.tests import TestEnv
+from pythran.config import cfg
 from pythran.typing import List, NDArray
 import numpy as np
 
@@ -81,6 +82,32 @@ class TestList(TestEnv):
                       [np.array([3,4])],
                       add_list_of_arrays=[List[NDArray[int, :]], List[NDArray[int, :]]])
 
+    def test_borrowed_list_of_arrays(self):
+        code = '''
+def borrowed_list_of_arrays(x):
+    s = x[-1][0] + x[len(x) - 2][1]
+    for a in x:
+        s += a.sum()
+    return s, 2 in x[0]'''
+        cfg.set('pythran', 'borrowed_arguments', 'True')
+        try:
+            self.run_test(code,
+                          [np.array([1,2]), np.array([3,4]), np.array([2,0])],
+                          borrowed_list_of_arrays=[List[NDArray[int, :]]])
+        finally:
+            cfg.set('pythran', 'borrowed_arguments', 'False')
+
+    def test_borrowed_list_slice_index(self):
+        code = '''
+def borrowed_list_slice_index(x, s):
+    return x[s], len(x)'''
+        cfg.set('pythran', 'borrowed_arguments', 'True')
+        try:
+            self.run_test(code, [1, 2, 3, 4], slice(1, 3),
+                          borrowed_list_slice_index=[List[int], slice])
+        finally:
+            cfg.set('pythran', 'borrowed_arguments', 'False')
+
     def test_slice_get_item_assign(self):
         self.run_test('def slice_get_item_assign(x): y = x[:]; y.remove(0); return x, y',
                       [0, 1,2,3],
@@ -1166,3 +1166,41 @@ def hanning(M):
         self.run_test(code,
                       numpy.arange(200.).reshape(10, 20),
                       subscripting_slice_array_transpose=[NDArray[float, :, :]])
+
+    def test_ndarray_pool_round_trip(self):
+        code = '''
+            import numpy as np
+            def ndarray_pool_round_trip(n):
+                kept = []
+                for size in range(1, n):
+                    # released at once, its buffer is reused by the next sizes
+                    t = np.ones(size * 3) + size
+                    kept.append(np.ones(size, dtype=np.int32) * int(t[0]))
+                return sum(int(k.sum()) for k in kept), sum(k.size for k in kept)'''
+        self.run_test(code, 600, ndarray_pool_round_trip=[int])
+
+    def test_ndarray_pool_grow(self):
+        code = '''
+            import numpy as np
+            def ndarray_pool_grow(n):
+                # each buffer is one element larger than the previous one,
+                # so that released buffers are reused for larger sizes of
+                # their class, and classes get crossed
+                a = np.ones(1)
+                for i in range(n):
+                    a = np.append(a, i)
+                return a.sum(), a.size, a[-5:]'''
+        self.run_test(code, 1000, ndarray_pool_grow=[int])
+
+    def test_ndarray_pool_free(self):
+        # the buffers we return come from the pool, numpy releases them
+        # through free()
+        code = ("import numpy as np\n"
+                "def ndarray_pool_free(n):\n"
+                "    a = np.ones(n)\n"
+                "    for i in range(3):\n"
+                "        a = a + i\n"
+                "    return a")
+        runas = "sum(ndarray_pool_free(n).sum() for n in range(1, 300))"
+        self.run_test_case(code, "ndarray_pool_free", runas,
+                           ndarray_pool_free=[int])
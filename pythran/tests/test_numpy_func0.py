@@ -1,5 +1,6 @@
 import unittest
 from pythran.tests import TestEnv
+from tempfile import mkstemp
 import numpy
 import sys
 
@@ -245,6 +246,21 @@ def np_rosen_der(x):
     def test_median1(self):
         self.run_test("def np_median1(a): from numpy import median ; return median(a)", numpy.array([1, 2, 3, 4,5]), np_median1=[NDArray[int,:]])
 
+    def test_median2(self):
+        self.run_test("def np_median2(a): from numpy import median ; return median(a, 1)", numpy.arange(24.).reshape(2, 3, 4) % 7, np_median2=[NDArray[float,:,:,:]])
+
+    def test_median3(self):
+        self.run_test("def np_median3(a): from numpy import median ; return median(a[::2].T, 0)", numpy.arange(30).reshape(6, 5) % 11, np_median3=[NDArray[int,:,:]])
+
+    def test_nanmedian0(self):
+        self.run_test("def np_nanmedian0(a): from numpy import nanmedian ; return nanmedian(a), nanmedian(a, 0)", numpy.array([[1., numpy.nan, 3.], [4., 2., numpy.nan]]), np_nanmedian0=[NDArray[float,:,:]])
+
+    def test_percentile0(self):
+        self.run_test("def np_percentile0(a): from numpy import percentile ; return percentile(a, 30), percentile(a, 75., -1)", numpy.arange(24).reshape(4, 6) % 5, np_percentile0=[NDArray[int,:,:]])
+
+    def test_quantile0(self):
+        self.run_test("def np_quantile0(a): from numpy import quantile ; return quantile(a, .3, 0)", numpy.arange(24.).reshape(4, 6) % 5, np_quantile0=[NDArray[float,:,:]])
+
     def test_mean0(self):
         self.run_test("def np_mean0(a): from numpy import mean ; return mean(a)", numpy.array([[1, 2], [3, 4]]), np_mean0=[NDArray[int,:,:]])
 
@@ -308,6 +324,15 @@ def np_rosen_der(x):
     def test_lexsort2(self):
         self.run_test("def np_lexsort2(a): from numpy import lexsort ; return lexsort((a+1,a-1))", numpy.array([1,5,1,4,3,4,4]), np_lexsort2=[NDArray[int,:]])
 
+    def test_lexsort3(self):
+        self.run_test("def np_lexsort3(a): from numpy import lexsort ; return lexsort((a, a % 3), 0)", numpy.arange(300 * 4).reshape(300, 4) % 17, np_lexsort3=[NDArray[int,:,:]])
+
+    def test_lexsort4(self):
+        self.run_test("def np_lexsort4(n): from numpy import lexsort, arange ; x = arange(n) % 3 ; y = arange(n) % 2 ; return lexsort((x, y)), lexsort((x, y), 0)", 40, np_lexsort4=[int])
+
+    def test_lexsort5(self):
+        self.run_test("def np_lexsort5(a): from numpy import lexsort ; return lexsort((a % 2, a))", numpy.array([1., numpy.nan, 3., 1., numpy.nan, 0., 2.]), np_lexsort5=[NDArray[float,:]])
+
     def test_issctype0(self):
         self.run_test("def np_issctype0(): from numpy import issctype, int32 ; a = int32 ; return issctype(a)", np_issctype0=[])
 
@@ -383,6 +408,38 @@ def np_rosen_der(x):
     def test_fromstring3(self):
         self.run_test("def np_fromstring3(a): from numpy import fromstring, uint32 ; return fromstring(a, uint32,2, ',')", '1,2, 3, 4', np_fromstring3=[str])
 
+    @unittest.skipIf(sys.version_info.major == 3, "Not supported in Pythran3")
+    def test_frombuffer0(self):
+        self.run_test("def np_frombuffer0(a): from numpy import frombuffer, uint8 ; return frombuffer(a, uint8, 2, 1)", '\x01\x02\x03\x04', np_frombuffer0=[str])
+
+    def test_fromfile0(self):
+        self.run_test("def np_fromfile0(a, fn): from numpy import fromfile, float64 ; a.tofile(fn) ; return fromfile(fn, float64)", numpy.arange(1000.), mkstemp()[1], np_fromfile0=[NDArray[float,:], str])
+
+    def test_fromfile1(self):
+        self.run_test("def np_fromfile1(a, fn): from numpy import fromfile, int64 ; a.tofile(fn) ; f = open(fn, 'rb') ; return fromfile(f, int64, 3, offset=16), fromfile(f, int64)", numpy.arange(10), mkstemp()[1], np_fromfile1=[NDArray[int,:], str])
+
+    def test_tofile0(self):
+        self.run_test("def np_tofile0(a, fn): (a + 1).tofile(fn, sep=',') ; return open(fn).read()", numpy.arange(10), mkstemp()[1], np_tofile0=[NDArray[int,:], str])
+
+    def test_memmap0(self):
+        self.run_test("def np_memmap0(a, fn): from numpy import memmap, float64 ; a.tofile(fn) ; m = memmap(fn, float64, 'r+', 8, (3, 3)) ; m[1, 1] = -1 ; return m.sum(), memmap(fn, float64, 'r').tolist()", numpy.arange(10.), mkstemp()[1], np_memmap0=[NDArray[float,:], str])
+
+    def test_memmap1(self):
+        self.run_test("def np_memmap1(fn): from numpy import memmap, int64 ; m = memmap(fn, int64, 'w+', shape=5) ; m[:] = 3 ; return memmap(fn, int64, mode='c').tolist()", mkstemp()[1], np_memmap1=[str])
+
+    def test_memmap2(self):
+        from pythran import compile_pythrancode
+        fn = mkstemp()[1]
+        numpy.arange(4.).tofile(fn)
+        code = "def np_memmap2(fn): from numpy import memmap, float64 ; return memmap(fn, float64, 'r')"
+        module_path = compile_pythrancode("test_np_memmap2", code,
+                                          {"np_memmap2": [str]},
+                                          extra_compile_args=self.PYTHRAN_CXX_FLAGS)
+        res = self.run_pythran("test_np_memmap2", module_path,
+                               ("np_memmap2", (fn,)))
+        self.assertFalse(res.flags.writeable)
+        self.assertEqual(res.tolist(), [0., 1., 2., 3.])
+
     def test_outer0(self):
         self.run_test("def np_outer0(x): from numpy import outer ; return outer(x, x+2)", numpy.arange(6).reshape(2,3), np_outer0=[NDArray[int,:,:]])
 
@@ -557,6 +614,12 @@ def np_rosen_der(x):
     def test_sort7(self):
         self.run_test("def np_sort7(a): from numpy import sort ; return sort(a, 2, kind='mergesort')", numpy.arange(2*3*7, 0, -1).reshape(2,3,7), np_sort7=[NDArray[int, :, :, :]])
 
+    def test_sort8(self):
+        self.run_test("def np_sort8(a): from numpy import sort ; return sort(a, kind='stable')", numpy.array([[3., numpy.nan, -0., 1e300], [numpy.inf, -1., 0., -numpy.inf]] * 200), np_sort8=[NDArray[float, :, :]])
+
+    def test_sort9(self):
+        self.run_test("def np_sort9(a): from numpy import sort ; return sort(a, 0)", numpy.arange(300 * 5, 0, -1).reshape(300, 5) % 7 - 3, np_sort9=[NDArray[int, :, :]])
+
     def test_sort_complex0(self):
         self.run_test("def np_sort_complex0(a): from numpy import sort_complex ; return sort_complex(a)", numpy.array([[1,6],[7,5]]), np_sort_complex0=[NDArray[int,:,:]])
 
@@ -15,6 +15,13 @@ class TestNumpyFunc1(TestEnv):
     def test_sum_expr(self):
         self.run_test("def np_sum_expr(a):\n from numpy import ones\n return (a + ones(10)).sum()", numpy.arange(10), np_sum_expr=[NDArray[int,:]])
 
+    def test_sum_pairwise(self):
+        self.run_test("def np_sum_pairwise(a): return abs(a.sum() - 1e4) < .01, abs(a[1:].sum() - 9999.9) < .01, abs(a.reshape(100, 1000).T.sum() - 1e4) < .01", numpy.full(100000, .1, dtype=numpy.float32), np_sum_pairwise=[NDArray[numpy.float32,:]])
+
+    def test_sum_pairwise_numpy(self):
+        # values computed by numpy, that pythran should match to the last bit
+        self.run_test("def np_sum_pairwise_numpy(a): return a.sum() == 100000.109375, a[1:].sum() == 100000.0078125, (a + a).sum() == 200000.21875, a[::2].sum() == 50000.1015625", numpy.full(1000001, .1, dtype=numpy.float32), np_sum_pairwise_numpy=[NDArray[numpy.float32,:]])
+
     def test_sum2_(self):
         self.run_test("def np_sum2_(a): return a.sum()", numpy.arange(10).reshape(2,5), np_sum2_=[NDArray[int,:,:]])
 
@@ -192,6 +192,18 @@ class TestNumpyFunc2(TestEnv):
                   numpy.arange(7,dtype=float),
                   np_correlate_11=[NDArray[numpy.float32,:],NDArray[float,:]])
 
+    def test_correlate_fft(self):
+        self.run_test("def np_correlate_fft(a,b):\n from numpy import correlate\n return correlate(a,b,'same')",
+                  numpy.sin(numpy.arange(5000.)),
+                  numpy.cos(numpy.arange(301.)),
+                  np_correlate_fft=[NDArray[float,:],NDArray[float,:]])
+
+    def test_correlate_fft_complex(self):
+        self.run_test("def np_correlate_fft_complex(a,b):\n from numpy import correlate\n return correlate(a,b,'full')",
+                  numpy.arange(300.) + 1j*numpy.sin(numpy.arange(300.)),
+                  numpy.arange(2000.) - 1j*numpy.cos(numpy.arange(2000.)),
+                  np_correlate_fft_complex=[NDArray[complex,:],NDArray[complex,:]])
+
     def test_convolve_1(self):
         self.run_test("def np_convolve_1(a,b):\n from numpy import convolve\n return convolve(a,b)",
                       numpy.arange(10,dtype=float),
@@ -259,6 +271,12 @@ class TestNumpyFunc2(TestEnv):
                   numpy.arange(12,dtype=numpy.float32),
                   numpy.arange(7,dtype=float),
                   np_convolve_11=[NDArray[numpy.float32,:],NDArray[float,:]])
+
+    def test_convolve_fft(self):
+        self.run_test("def np_convolve_fft(a,b):\n from numpy import convolve\n return convolve(a,b,'valid')",
+                  numpy.sin(numpy.arange(5000, dtype=numpy.float32)),
+                  numpy.cos(numpy.arange(128, dtype=numpy.float32)),
+                  np_convolve_fft=[NDArray[numpy.float32,:],NDArray[numpy.float32,:]])
         
     def test_copy0(self):
         code= '''
@@ -567,6 +585,27 @@ def test_copy0(x):
     def test_argsort1(self):
         self.run_test("def np_argsort1(x): return x.argsort()", numpy.array([[3, 1, 2], [1 , 2, 3]]), np_argsort1=[NDArray[int,:,:]])
 
+    def test_argsort2(self):
+        self.run_test("def np_argsort2(x): from numpy import argsort ; return argsort(x, 0, 'stable')", numpy.arange(2 * 300, 0, -1).reshape(300, 2) % 7, np_argsort2=[NDArray[int,:,:]])
+
+    def test_argsort3(self):
+        self.run_test("def np_argsort3(x): from numpy import argsort ; return argsort(x, kind='mergesort')", numpy.array([0.5, numpy.nan, -0., 0., -numpy.inf, 0.5] * 100), np_argsort3=[NDArray[float,:]])
+
+    def test_argsort4(self):
+        self.run_test("def np_argsort4(x): return x.argsort(1)", numpy.arange(4 * 100 * 3, 0, -1).reshape(4, 100, 3) % 101, np_argsort4=[NDArray[int,:,:,:]])
+
+    def test_argpartition0(self):
+        self.run_test("def np_argpartition0(x): from numpy import sort ; i = x.argpartition(-10) ; return sort(x[i[-10:]]), x[i[-10]]", numpy.sin(numpy.arange(1000.)), np_argpartition0=[NDArray[float,:]])
+
+    def test_argpartition1(self):
+        self.run_test("def np_argpartition1(x): from numpy import argpartition, sort ; i = argpartition(x, [0, 2], 0) ; return i[0], i[2], sort(i[3:], 0)", numpy.arange(3 * 50).reshape(50, 3) * 7 % 151, np_argpartition1=[NDArray[int,:,:]])
+
+    def test_partition0(self):
+        self.run_test("def np_partition0(x): from numpy import partition, sort ; p = partition(x, 3) ; return p[3], sort(p[:3]), sort(p[4:])", numpy.array([5, 1, 9, 3, 7, 3, 0, 8]), np_partition0=[NDArray[int,:]])
+
+    def test_partition1(self):
+        self.run_test("def np_partition1(x): from numpy import partition ; p = partition(x.T, [1, -2]) ; return p[:, 1], p[:, -2]", numpy.cos(numpy.arange(300.)).reshape(100, 3), np_partition1=[NDArray[float,:,:]])
+
     def test_argmax0(self):
         self.run_test("def np_argmax0(a): return a.argmax()", numpy.arange(6).reshape(2,3), np_argmax0=[NDArray[int,:,:]])
 
@@ -576,6 +615,9 @@ def test_copy0(x):
     def test_argmax2(self):
         self.run_test("def np_argmax2(a): from numpy import argmax ; return argmax(a, 0)", numpy.arange(30).reshape(2,3,5), np_argmax2=[NDArray[int,:,:,:]])
 
+    def test_argmax3(self):
+        self.run_test("def np_argmax3(a): from numpy import argmax ; return argmax(a % 10), argmax(-(a % 10.))", numpy.arange(100), np_argmax3=[NDArray[int,:]])
+
     def test_argmin0(self):
         self.run_test("def np_argmin0(a): return a.argmin()", numpy.arange(6).reshape(2,3), np_argmin0=[NDArray[int,:,:]])
 
@@ -5,6 +5,8 @@ import unittest
 import numpy
 from pythran.typing import List, NDArray, Tuple
 
+from pythran import compile_pythrancode
+from pythran.config import make_extension
 from pythran.tests import TestEnv
 
 
@@ -218,7 +220,97 @@ class TestNumpyFunc3(TestEnv):
                       numpy.array(numpy.arange(18.).reshape(6,3)),
                       np_dot19=[NDArray[float,:,:], NDArray[float,:,:]])
 
+    def test_dot20(self):
+        """ Check for dot gemm with "no blas type", larger than a block, first
+        arg transposed."""
+        self.run_test("""
+        def np_dot20(x, y):
+            from numpy import dot
+            return dot(x.T,y)""",
+                      numpy.arange(300 * 101).reshape(300, 101) % 17,
+                      numpy.arange(300 * 37).reshape(300, 37) % 13,
+                      np_dot20=[NDArray[int,:,:], NDArray[int,:,:]])
 
+    def test_dot21(self):
+        """ Check for dot with mixed types and strided views."""
+        self.run_test("""
+        def np_dot21(x, y):
+            from numpy import dot
+            return dot(x[::2, 1:], y[:, ::-3]), dot(y[1], x[:, ::2])""",
+                      numpy.arange(70).reshape(10, 7),
+                      numpy.arange(60.).reshape(6, 10),
+                      np_dot21=[NDArray[int,:,:], NDArray[float,:,:]])
+
+    def test_dot22(self):
+        """ Check for dot with "no blas type" and an output argument."""
+        self.run_test("""
+        def np_dot22(x, y):
+            from numpy import dot, empty
+            z = empty((7, 5), int)
+            dot(x, y, z)
+            return z""",
+                      numpy.arange(42).reshape(7, 6),
+                      numpy.arange(30).reshape(6, 5),
+                      np_dot22=[NDArray[int,:,:], NDArray[int,:,:]])
+
+    def test_dot23(self):
+        """ Check for dot with an output argument aliasing the operands."""
+        self.run_test("""
+        def np_dot23(x, y):
+            from numpy import dot
+            dot(x, x.T, x)
+            dot(x[::-1], x, x)
+            dot(y, y, y)
+            return x, y""",
+                      numpy.arange(36).reshape(6, 6),
+                      numpy.arange(16.).reshape(4, 4),
+                      np_dot23=[NDArray[int,:,:], NDArray[float,:,:]])
+
+    def test_dot24(self):
+        """ Check for dot with an output argument of the wrong shape."""
+        self.run_test("""
+        def np_dot24(x, y):
+            from numpy import dot, empty
+            z = empty((x.shape[1], x.shape[1]), int)
+            try:
+                dot(x, y, z)
+                return False
+            except ValueError:
+                return True""",
+                      numpy.arange(42).reshape(7, 6),
+                      numpy.arange(30).reshape(6, 5),
+                      np_dot24=[NDArray[int,:,:], NDArray[int,:,:]])
+
+    def test_dot25(self):
+        """ Check for dot with blas=none, through the in-tree kernels."""
+        config = ['compiler.blas=none']
+        self.assertIn(('PYTHRAN_BLAS_NONE', None),
+                      make_extension(python=True,
+                                     config=config)['define_macros'])
+        code = """
+def np_dot25(x, y, z):
+    from numpy import dot, complex64, float32
+    from numpy.linalg import matrix_power
+    w = z.astype(complex64)
+    return (dot(x[0], y[:, 0]), dot(x, y[:, 1]), dot(x, y),
+            dot(x.T[:30], x), dot(y[:60].T, x[:, :60].T),
+            dot(z, z.T), dot(w, w), dot(w[0], w),
+            dot(x.astype(float32), y.astype(float32)),
+            matrix_power(z.real, 3))"""
+        # integral values, so that the results are exact
+        params = (numpy.arange(67 * 130.).reshape(67, 130) % 7 - 3,
+                  numpy.arange(130 * 71.).reshape(130, 71) % 11 - 5,
+                  numpy.arange(33 * 33.).reshape(33, 33) % 5 +
+                  1j * (numpy.arange(33 * 33.).reshape(33, 33) % 3))
+        module_path = compile_pythrancode(
+            "test_np_dot25", code,
+            {"np_dot25": [NDArray[float,:,:], NDArray[float,:,:],
+                          NDArray[complex,:,:]]},
+            extra_compile_args=self.PYTHRAN_CXX_FLAGS, config=config)
+        ref = self.run_python(code, ("np_dot25", params))
+        res = self.run_pythran("test_np_dot25", module_path,
+                               ("np_dot25", params))
+        self.assertAlmostEqual(ref, res)
 
     def test_digitize0(self):
         self.run_test("def np_digitize0(x): from numpy import array, digitize ; bins = array([0.0, 1.0, 2.5, 4.0, 10.0]) ; return digitize(x, bins)", numpy.array([0.2, 6.4, 3.0, 1.6]), np_digitize0=[NDArray[float,:]])
@@ -331,6 +423,9 @@ def np_trim_zeros2(x):
     def test_unique4(self):
         self.run_test("def np_unique4(x): from numpy import unique ; return unique(x, True, True, True)", numpy.array([1,1,2,2,2,1,5]), np_unique4=[NDArray[int,:]])
 
+    def test_unique5(self):
+        self.run_test("def np_unique5(x): from numpy import unique ; return unique(x, True, True, True)", numpy.array([[1.5,1,2],[2,1.5,-5]]), np_unique5=[NDArray[float,:,:]])
+
     def test_unwrap0(self):
         self.run_test("def np_unwrap0(x): from numpy import unwrap, pi ; x[:3] += 2*pi; return unwrap(x)", numpy.arange(6, dtype=float), np_unwrap0=[NDArray[float,:]])
 
@@ -317,6 +317,18 @@ class TestNumpyRandom(TestEnv):
         """
         self.run_test(code, 10 ** 3, numpy_normal2=[int])
 
+    def test_numpy_normal3(self):
+        """Check normal with a size that is not a multiple of a draw block."""
+        code = """
+        def numpy_normal3(size):
+            from numpy.random import normal
+            from numpy import mean, std, isfinite
+            a = normal(2., 3., size)
+            return (isfinite(a).all() and abs(mean(a) - 2) < .1 and
+                    abs(std(a) - 3) < .1)
+        """
+        self.run_test(code, 10 ** 5 + 7, numpy_normal3=[int])
+
     ###########################################################################
     #Tests for numpy.random.poisson
     ###########################################################################
@@ -1555,4 +1567,20 @@ class TestNumpyRandom(TestEnv):
             a = logseries(s, (size, size))
             return (abs(mean(a) - rmean) < .05 and abs(var(a) - rvar) < .05)
         """
-        self.run_test(code, 10 ** 3, numpy_logseries2=[int])
\ No newline at end of file
+        self.run_test(code, 10 ** 3, numpy_logseries2=[int])
+    ###########################################################################
+    #Tests for numpy.random.seed
+    ###########################################################################
+
+    def test_numpy_seed0(self):
+        """Check that seeding makes large array fills reproducible."""
+        code = """
+        def numpy_seed0(size):
+            from numpy.random import seed, normal, gumbel
+            seed(3)
+            a, b = normal(size=size), gumbel(size=size)
+            seed(3)
+            c, d = normal(size=size), gumbel(size=size)
+            return (a == c).all() and (b == d).all() and not (a == b).all()
+        """
+        self.run_test(code, 10 ** 5, numpy_seed0=[int])
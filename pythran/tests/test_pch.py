@@ -0,0 +1,68 @@
+""" Tests for the precompiled header build mode. """
+
+from imp import load_dynamic
+
+from pythran import cache, compile_pythrancode
+from pythran.tests import TestEnv
+
+import glob
+import numpy
+import os
+import shutil
+import sys
+import tempfile
+import unittest
+
+
+@unittest.skipIf(sys.platform == 'win32', "gcc-like compilers only")
+class TestPch(TestEnv):
+
+    code = '''
+#pythran export pch(float[], int)
+import numpy
+def pch(a, n):
+    return numpy.sum(a ** 2) + n, numpy.arange(n) * a[0], str(n)'''
+
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def compile(self, modname, pch):
+        # precompiled headers live in the compilation cache
+        config = ['cache.directory=' + self.directory, 'cache.max_size=1024',
+                  'compiler.pch={}'.format(pch)]
+        module_path = compile_pythrancode(
+            modname, self.code, config=config,
+            extra_compile_args=self.PYTHRAN_CXX_FLAGS)
+        try:
+            return load_dynamic(modname, module_path)
+        finally:
+            os.remove(module_path)
+
+    def pchs(self):
+        return glob.glob(os.path.join(self.directory, 'pch', '*',
+                                      cache.pch_header + '.?ch'))
+
+    def test_pch(self):
+        args = numpy.arange(5.), 3
+        ref = self.compile('test_pch_ref', False).pch(*args)
+        self.assertEqual(self.pchs(), [])
+        res = self.compile('test_pch', True).pch(*args)
+        self.assertAlmostEqual(ref, res)
+        pchs = self.pchs()
+        self.assertEqual(len(pchs), 1)
+
+        # built once, then shared by the modules compiled with the same flags
+        if pchs[0].endswith('.gch'):
+            # gcc never reads a header it has a usable .gch for
+            with open(pchs[0][:-len('.gch')], 'w') as header:
+                header.write('#error the precompiled header is not used\n')
+        res = self.compile('test_pch_again', True).pch(*args)
+        self.assertAlmostEqual(ref, res)
+        self.assertEqual(self.pchs(), pchs)
+
+
+if __name__ == '__main__':
+    unittest.main()
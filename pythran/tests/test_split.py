@@ -0,0 +1,98 @@
+""" Tests for modules compiled as several translation units. """
+
+from imp import load_dynamic
+
+from pythran import compile_pythrancode, compile_cxxfile
+from pythran.tests import TestEnv
+
+import numpy
+import os
+import shutil
+import tempfile
+import unittest
+
+
+class TestSplit(TestEnv):
+
+    code = '''
+#pythran export scale(int list, int)
+#pythran export scale(float list, float)
+#pythran export scale(float[], float)
+#pythran export total(int[:,:])
+#pythran export total(float[:,:])
+#pythran export check(int)
+#pythran export draw(int)
+#pythran export draw()
+import random
+def scale(l, f):
+    return [x * f for x in l]
+def total(a):
+    return a.sum(axis=0)
+def check(n):
+    if n < 0:
+        raise ValueError("negative")
+    return n
+def draw(seed=-1):
+    if seed >= 0:
+        random.seed(seed)
+    return random.random()'''
+
+    def load(self, modname, module_path):
+        try:
+            return load_dynamic(modname, module_path)
+        finally:
+            os.remove(module_path)
+
+    def compile(self, modname, **kwargs):
+        module_path = compile_pythrancode(
+            modname, self.code, extra_compile_args=self.PYTHRAN_CXX_FLAGS,
+            **kwargs)
+        return self.load(modname, module_path)
+
+    def run_module(self, module):
+        res = [module.scale([1, 2], 3),
+               module.scale([1.5], 2.),
+               module.scale(numpy.arange(3.), 2.),
+               module.total(numpy.arange(6).reshape(2, 3)).tolist(),
+               module.total(numpy.ones((2, 2))).tolist(),
+               module.check(2)]
+        with self.assertRaises(ValueError):
+            module.check(-1)
+        with self.assertRaises(TypeError):
+            module.check(1.5)
+        # the random state is shared by all the specializations
+        res.append([module.draw(4), module.draw(), module.draw(4)])
+        self.assertEqual(res[-1][0], res[-1][2])
+        return res
+
+    def test_split(self):
+        ref = self.run_module(self.compile('test_split_ref'))
+        res = self.run_module(self.compile('test_split', split=3))
+        self.assertEqual(ref, res)
+
+    def test_split_translate_only(self):
+        ref = self.run_module(self.compile('test_split_cpp_ref'))
+        directory = tempfile.mkdtemp()
+        try:
+            main = os.path.join(directory, 'test_split_cpp.cpp')
+            compile_pythrancode('test_split_cpp', self.code, cpponly=True,
+                                output_file=main, split=3)
+            self.assertEqual(sorted(os.listdir(directory)),
+                             ['test_split_cpp.cpp', 'test_split_cpp.hpp',
+                              'test_split_cpp_0.cpp', 'test_split_cpp_1.cpp',
+                              'test_split_cpp_2.cpp'])
+            sources = sorted(os.path.join(directory, f)
+                             for f in os.listdir(directory)
+                             if f.endswith('.cpp'))
+            module_path = compile_cxxfile(
+                'test_split_cpp', sources,
+                output_binary=os.path.join(directory, 'test_split_cpp.so'),
+                extra_compile_args=self.PYTHRAN_CXX_FLAGS)
+            res = self.run_module(self.load('test_split_cpp', module_path))
+        finally:
+            shutil.rmtree(directory)
+        self.assertEqual(ref, res)
+
+
+if __name__ == '__main__':
+    unittest.main()
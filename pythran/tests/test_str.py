@@ -209,6 +209,7 @@ class TestStr(TestEnv):
 
     def test_str_id(self):
         self.run_test("def str_id(x): return id(x) != 0", "hello", str_id=[str])
+
 """
     def test_str_slice_assign(self):
         self.run_test('''
@@ -240,4 +241,41 @@ class TestStr(TestEnv):
 
         def str_slice_assign2(s1):
             sample_datatype(s1)
-            return s1''', "LEFT-B6", str_slice_assign2=[str])
\ No newline at end of file
+            return s1''', "LEFT-B6", str_slice_assign2=[str])
+
+    def test_str_partition(self):
+        self.run_test("def str_partition(s, sep): return s.partition(sep), s.partition('#')",
+                      "a rather long key = a rather long value", " = ",
+                      str_partition=[str, str])
+
+    def test_str_split_views(self):
+        self.run_test("def str_split_views(s): f = s.split(','); return [x.strip()[1:] + '|' for x in f], f[1][2:8], ';'.join(f)",
+                      "first field is long , 2nd,   third field is long too  ,4",
+                      str_split_views=[str])
+
+    @unittest.skipIf(not sys.platform.startswith('linux'), "needs /proc")
+    def test_str_views_release(self):
+        code = """
+def resident():
+    return int(open('/proc/self/statm').read().split()[1]) * 4096
+def str_views_release(n):
+    before = resident()
+    heads = []
+    for i in range(n):
+        line = 'y' * 100 + ' ' + 'x' * 4000000 + str(i)
+        heads.append(line.split()[0])
+    # the heads do not keep their lines alive
+    return resident() - before < n * 2000000, len(heads)"""
+        self.run_test(code, 50, str_views_release=[int])
+
+    def test_str_chars(self):
+        self.run_test("def str_chars(s): return [c for c in s if c != ','], s[3], s[-1]",
+                      "a,bb,ccc" * 100, str_chars=[str])
+
+    def test_str_copy_upper(self):
+        self.run_test("def str_copy_upper(s): t = s[1:]; return t, t.upper(), s.upper(), s",
+                      "a string longer than the inline storage", str_copy_upper=[str])
+
+    def test_str_id_copies(self):
+        self.run_test("def str_id_copies(s): t = s; u = s.strip('a'); v = u; l = [s, u]; return id(t) == id(s), id(v) == id(u), id(l[0]) == id(s), id(l[1]) == id(u)",
+                      "a string longer than the inline storage", str_id_copies=[str])
@@ -0,0 +1,69 @@
+""" Tests for the compilation time report. """
+
+from subprocess import check_output
+
+from pythran import compile_pythrancode
+from pythran.time_report import TimeReport
+
+import os
+import re
+import shutil
+import sys
+import tempfile
+import unittest
+
+
+class TestTimeReport(unittest.TestCase):
+
+    code = '''
+#pythran export time_report(int list)
+def time_report(l):
+    return sum(x * 2 for x in l)'''
+
+    phases = ['front end', 'middle end', 'back end', 'C++ compilation']
+
+    def setUp(self):
+        self.directory = tempfile.mkdtemp()
+
+    def tearDown(self):
+        shutil.rmtree(self.directory)
+
+    def test_report(self):
+        report = TimeReport()
+        module_path = compile_pythrancode(
+            'time_report', self.code, time_report=report,
+            output_file=os.path.join(self.directory, 'time_report.so'))
+        self.assertTrue(os.path.exists(module_path))
+        self.assertEqual([name for name, _ in report.phases], self.phases)
+        self.assertTrue(all(elapsed >= 0 for _, elapsed in report.phases))
+        runs, hits, _ = report.passes['Aliases']
+        self.assertGreater(runs, 0)
+        self.assertGreater(hits, 0)
+
+    def test_command_line(self):
+        source = os.path.join(self.directory, 'time_report.py')
+        with open(source, 'w') as out:
+            out.write(self.code)
+        output = check_output([sys.executable, '-m', 'pythran.run',
+                               '--time-report', source, '-o',
+                               os.path.join(self.directory,
+                                            'time_report.so')],
+                              universal_newlines=True)
+        lines = output.splitlines()
+        self.assertEqual(lines[0].split(), ['Phase', 'time'])
+        for line, name in zip(lines[1:], self.phases):
+            pattern = r'^{} +\d+\.\d{{3}}s$'.format(re.escape(name))
+            self.assertTrue(re.match(pattern, line), line)
+        self.assertEqual(lines[len(self.phases) + 1], '')
+        self.assertEqual(lines[len(self.phases) + 2].split(),
+                         ['Pass', 'runs', 'hits', 'time'])
+        passes = lines[len(self.phases) + 3:]
+        self.assertTrue(passes)
+        for line in passes:
+            self.assertTrue(re.match(r'^\w+ +\d+ +\d+ +\d+\.\d{3}s$', line),
+                            line)
+        self.assertTrue(any(re.match(r'^Aliases ', line) for line in passes))
+
+
+if __name__ == '__main__':
+    unittest.main()
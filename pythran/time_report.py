@@ -0,0 +1,128 @@
+'''
+This module gathers where the time goes while compiling a module:
+    * TimeReport records the wall time of each compilation phase, and of each
+      pass run by the PassManager, along with analysis cache hits;
+    * phase is a context manager timing a phase, if a report is active;
+    * template_hotspots summarizes the clang -ftime-trace output of the C++
+      compilation, grouping instantiations by pythonic template.
+'''
+
+from collections import defaultdict
+from contextlib import contextmanager
+import json
+import os
+import time
+
+
+class TimeReport(object):
+    '''
+    Wall time of each compilation phase and of each pass.
+
+    Pass times exclude the time spent in the passes they trigger, so that they
+    add up to the time of the front and middle end.
+    '''
+
+    def __init__(self, trace=False):
+        # whether the C++ compiler should trace its own execution
+        self.trace = trace
+        self.phases = []
+        # pass name -> [runs, cache hits, self time]
+        self.passes = defaultdict(lambda: [0, 0, 0.])
+        # pass name, start time, time spent in nested passes
+        self.stack = []
+        # (template, time, instantiations), most expensive first
+        self.templates = []
+
+    def enter(self, pass_):
+        self.stack.append([pass_.__name__, time.time(), 0.])
+
+    def leave(self):
+        name, start, nested = self.stack.pop()
+        elapsed = time.time() - start
+        stats = self.passes[name]
+        stats[0] += 1
+        stats[2] += elapsed - nested
+        if self.stack:
+            self.stack[-1][2] += elapsed
+
+    def hit(self, pass_):
+        self.passes[pass_.__name__][1] += 1
+
+    def __str__(self):
+        lines = ['{:<32}{:>10}'.format('Phase', 'time')]
+        lines.extend('{:<32}{:>9.3f}s'.format(name, elapsed)
+                     for name, elapsed in self.phases)
+        if self.passes:
+            lines.append('')
+            lines.append('{:<32}{:>6}{:>6}{:>10}'.format('Pass', 'runs',
+                                                         'hits', 'time'))
+            ordered = sorted(self.passes.items(), key=lambda x: -x[1][2])
+            lines.extend('{:<32}{:>6}{:>6}{:>9.3f}s'.format(name, *stats)
+                         for name, stats in ordered)
+        if self.templates:
+            lines.append('')
+            lines.append('{:<56}{:>6}{:>10}'.format('Template', 'count',
+                                                    'time'))
+            lines.extend('{:<56}{:>6}{:>9.3f}s'.format(name[:55], count,
+                                                        elapsed)
+                         for name, elapsed, count in self.templates)
+        return '\n'.join(lines)
+
+
+@contextmanager
+def phase(report, name):
+    '''Times the enclosed statements as phase `name` of `report`.'''
+    if report is None:
+        yield
+        return
+    start = time.time()
+    try:
+        yield
+    finally:
+        report.phases.append((name, time.time() - start))
+
+
+def _template_name(detail):
+    '''Template name without its arguments nor the anonymous namespace.'''
+    name, depth = [], 0
+    for c in detail:
+        if c == '<':
+            depth += 1
+        elif c == '>' and depth:
+            depth -= 1
+        elif not depth:
+            name.append(c)
+    name = ''.join(name)
+    return name.replace('(anonymous namespace)::', '')
+
+
+def template_hotspots(trace_dir, count=20):
+    '''
+    Most expensive pythonic templates among the clang -ftime-trace files found
+    in `trace_dir`, as (template, time, instantiations).
+
+    Nested instantiations are accounted in their parent too, as the compiler
+    does.
+    '''
+    hotspots = defaultdict(lambda: [0., 0])
+    for dirpath, _, filenames in os.walk(trace_dir):
+        for filename in filenames:
+            if not filename.endswith('.json'):
+                continue
+            with open(os.path.join(dirpath, filename)) as fd:
+                try:
+                    events = json.load(fd).get('traceEvents', [])
+                except ValueError:
+                    continue
+            for event in events:
+                if event.get('name') not in ('InstantiateClass',
+                                             'InstantiateFunction'):
+                    continue
+                detail = event.get('args', {}).get('detail', '')
+                if 'pythonic::' not in detail:
+                    continue
+                stats = hotspots[_template_name(detail)]
+                stats[0] += event.get('dur', 0) * 1e-6
+                stats[1] += 1
+    ordered = sorted(hotspots.items(), key=lambda x: -x[1][0])
+    return [(name, elapsed, n) for name, (elapsed, n) in ordered[:count]]
@@ -3,7 +3,9 @@ This module contains all the stuff to make your way from python code to
 a dynamic library, see __init__.py for exported interfaces.
 '''
 
+from pythran.analyses import BorrowedArguments, GlobalEffects
 from pythran.backend import Cxx, Python
+from pythran import cache
 from pythran.config import cfg
 from pythran.cxxgen import PythonModule, Include, Line, Statement
 from pythran.cxxgen import FunctionBody, FunctionDeclaration, Value, Block
@@ -12,6 +14,7 @@ from pythran.dist import PythranExtension, PythranBuildExt
 from pythran.middlend import refine, mark_unexported_functions
 from pythran.passmanager import PassManager
 from pythran.tables import pythran_ward
+from pythran.time_report import phase, template_hotspots
 from pythran.types import tog
 from pythran.types.types import extract_constructed_types
 from pythran.types.type_dependencies import pytype_to_deps
@@ -35,7 +38,9 @@ import os.path
 import shutil
 import glob
 import hashlib
+import multiprocessing
 import sys
+import time
 from functools import reduce
 
 logger = logging.getLogger('pythran')
@@ -66,6 +71,19 @@ def _extract_specs_dependencies(specs):
     return sorted(deps, key=lambda x: "include" not in x)
 
 
+def _borrowed_ctypes(ctypes, indices):
+    '''Argument types of a specialization, with the containers at `indices'
+    accessed in place rather than converted.'''
+    borrowed = list(ctypes)
+    for i in indices:
+        for container in ('list', 'dict'):
+            prefix = 'pythonic::types::{}<'.format(container)
+            if i < len(borrowed) and borrowed[i].startswith(prefix):
+                borrowed[i] = 'pythonic::types::borrowed_{}<{}'.format(
+                    container, borrowed[i][len(prefix):])
+    return borrowed
+
+
 def _parse_optimization(optimization):
     '''Turns an optimization of the form
         my_optim
@@ -77,6 +95,20 @@ def _parse_optimization(optimization):
     return reduce(getattr, splitted[1:], __import__(splitted[0]))
 
 
+def _module_suffix():
+    return sysconfig.get_config_var('SO' if sys.version_info.major == 2
+                                    else 'EXT_SUFFIX')
+
+
+def _build_date():
+    '''Compilation date, fixed by $SOURCE_DATE_EPOCH for reproducible
+    builds.'''
+    epoch = os.environ.get('SOURCE_DATE_EPOCH')
+    if epoch:
+        return datetime.utcfromtimestamp(int(epoch))
+    return datetime.now()
+
+
 def _write_temp(content, suffix):
     '''write `content` to a temporary XXX`suffix` file and return the filename.
        It is user's responsibility to delete when done.'''
@@ -98,13 +130,14 @@ class HasArgument(ast.NodeVisitor):
 
 
 def front_middle_end(module_name, code, optimizations=None, module_dir=None,
-                     entry_points=None):
+                     entry_points=None, time_report=None):
     """Front-end and middle-end compilation steps"""
 
-    pm = PassManager(module_name, module_dir)
+    pm = PassManager(module_name, module_dir, time_report)
 
     # front end
-    ir, docstrings = frontend.parse(pm, code)
+    with phase(time_report, 'front end'):
+        ir, docstrings = frontend.parse(pm, code)
 
     if entry_points is not None:
         ir = mark_unexported_functions(ir, entry_points)
@@ -113,7 +146,8 @@ def front_middle_end(module_name, code, optimizations=None, module_dir=None,
     if optimizations is None:
         optimizations = cfg.get('pythran', 'optimizations').split()
     optimizations = [_parse_optimization(opt) for opt in optimizations]
-    refine(pm, ir, optimizations)
+    with phase(time_report, 'middle end'):
+        refine(pm, ir, optimizations)
 
     return pm, ir, docstrings
 
@@ -121,7 +155,8 @@ def front_middle_end(module_name, code, optimizations=None, module_dir=None,
 # PUBLIC INTERFACE STARTS HERE
 
 
-def generate_py(module_name, code, optimizations=None, module_dir=None):
+def generate_py(module_name, code, optimizations=None, module_dir=None,
+                time_report=None):
     '''python + pythran spec -> py code
 
     Prints and returns the optimized python code.
@@ -129,13 +164,14 @@ def generate_py(module_name, code, optimizations=None, module_dir=None):
     '''
 
     pm, ir, _ = front_middle_end(module_name, code, optimizations,
-                                    module_dir)
+                                 module_dir, time_report=time_report)
 
-    return pm.dump(Python, ir)
+    with phase(time_report, 'back end'):
+        return pm.dump(Python, ir)
 
 
 def generate_cxx(module_name, code, specs=None, optimizations=None,
-                 module_dir=None):
+                 module_dir=None, time_report=None):
     '''python + pythran spec -> c++ code
     returns a PythonModule object and an error checker
 
@@ -151,10 +187,12 @@ def generate_cxx(module_name, code, specs=None, optimizations=None,
 
     pm, ir, docstrings = front_middle_end(module_name, code, optimizations,
                                           module_dir,
-                                          entry_points=entry_points)
+                                          entry_points=entry_points,
+                                          time_report=time_report)
 
     # back-end
-    content = pm.dump(Cxx, ir)
+    with phase(time_report, 'back end'):
+        content = pm.dump(Cxx, ir)
 
     # instantiate the meta program
     if specs is None:
@@ -186,15 +224,40 @@ def generate_cxx(module_name, code, specs=None, optimizations=None,
         specs.to_docstrings(docstrings)
         check_exports(ir, specs)
 
+        # container arguments exported functions only read are accessed in
+        # place, which holds the GIL during the call
+        borrowed = {}
+        if cfg.getboolean('pythran', 'borrowed_arguments'):
+            indices = pm.gather(BorrowedArguments, ir)
+            borrowed = {node.name: indices[node] for node in ir.body
+                        if isinstance(node, ast.FunctionDef)}
+        borrowed_includes = set()
+        for function_name, signatures in specs.functions.items():
+            for signature in signatures:
+                ctypes = [pytype_to_ctype(t) for t in signature]
+                for ctype in _borrowed_ctypes(ctypes,
+                                              borrowed.get(function_name, ())):
+                    if ctype.startswith('pythonic::types::borrowed_'):
+                        container = ctype[len('pythonic::types::'):
+                                          ctype.index('<')]
+                        borrowed_includes.add(
+                            'pythonic/types/{}.hpp'.format(container))
+
         if isinstance(code, bytes):
             code_bytes = code
         else:
             code_bytes = code.encode('ascii', 'ignore')
         metainfo = {'hash': hashlib.sha256(code_bytes).hexdigest(),
                     'version': __version__,
-                    'date': datetime.now()}
+                    'date': _build_date()}
 
         mod = PythonModule(module_name, docstrings, metainfo)
+        # the runtime state these functions update, e.g. random generators,
+        # is private to each translation unit of a split module
+        effects = pm.gather(GlobalEffects, ir)
+        mod.stateful.update(node.name for node in ir.body
+                            if isinstance(node, ast.FunctionDef) and
+                            node in effects)
         mod.add_to_includes(
             Include("pythonic/core.hpp"),
             Include("pythonic/python/core.hpp"),
@@ -205,6 +268,8 @@ def generate_cxx(module_name, code, specs=None, optimizations=None,
         )
         mod.add_to_includes(*[Include(inc) for inc in
                               _extract_specs_dependencies(specs)])
+        mod.add_to_includes(*[Include(inc) for inc in
+                              sorted(borrowed_includes)])
         mod.add_to_includes(*content.body)
         mod.add_to_includes(
             Include("pythonic/python/exception_handler.hpp"),
@@ -224,7 +289,9 @@ def generate_cxx(module_name, code, specs=None, optimizations=None,
             for sigid, signature in enumerate(signatures):
                 numbered_function_name = "{0}{1}".format(internal_func_name,
                                                          sigid)
-                arguments_types = [pytype_to_ctype(t) for t in signature]
+                arguments_types = _borrowed_ctypes(
+                    [pytype_to_ctype(t) for t in signature],
+                    borrowed.get(function_name, ()))
                 arguments_names = HasArgument(function_name).visit(ir)
                 arguments = [n for n, _ in
                              zip(arguments_names, arguments_types)]
@@ -235,15 +302,11 @@ def generate_cxx(module_name, code, specs=None, optimizations=None,
                                                     "<{0}>".format(args_list)
                                                     if arguments_names else "")
                 result_type = "typename %s::result_type" % specialized_fname
-                mod.add_pyfunction(
-                    FunctionBody(
-                        FunctionDeclaration(
-                            Value(
-                                result_type,
-                                numbered_function_name),
-                            [Value(t + '&&', a)
-                             for t, a in zip(arguments_types, arguments)]),
-                        Block([Statement("""
+                if any(t.startswith('pythonic::types::borrowed_')
+                       for t in arguments_types):
+                    body = "return {0}()({1})"
+                else:
+                    body = """
                             PyThreadState *_save = PyEval_SaveThread();
                             try {{
                                 auto res = {0}()({1});
@@ -254,9 +317,18 @@ def generate_cxx(module_name, code, specs=None, optimizations=None,
                                 PyEval_RestoreThread(_save);
                                 throw;
                             }}
-                            """.format(warded(module_name,
-                                              internal_func_name),
-                                       ', '.join(arguments)))])
+                            """
+                mod.add_pyfunction(
+                    FunctionBody(
+                        FunctionDeclaration(
+                            Value(
+                                result_type,
+                                numbered_function_name),
+                            [Value(t + '&&', a)
+                             for t, a in zip(arguments_types, arguments)]),
+                        Block([Statement(body.format(
+                            warded(module_name, internal_func_name),
+                            ', '.join(arguments)))])
                     ),
                     function_name,
                     arguments_types,
@@ -300,38 +372,62 @@ def compile_cxxfile(module_name, cxxfile, output_binary=None, **kwargs):
     Return the filename of the produced shared library
     Raises CompileError on failure
 
+    `cxxfile` may also be a list of files, compiled concurrently and linked
+    in the same module
     '''
 
     builddir = mkdtemp()
     buildtmp = mkdtemp()
 
+    time_report = kwargs.pop('time_report', None)
+
+    cxxfiles = cxxfile if isinstance(cxxfile, list) else [cxxfile]
     extension = PythranExtension(module_name,
-                                 [cxxfile],
+                                 cxxfiles,
                                  **kwargs)
+    if len(cxxfiles) > 1:
+        # the numpy API table is defined by one of the translation units,
+        # which a precompiled header cannot express
+        extension.pch = False
+
+    trace = time_report is not None and time_report.trace
+    if trace:
+        cxx = extension.cxx or sysconfig.get_config_var('CXX') or 'c++'
+        if 'clang' in cache.compiler_version(cxx.split()[0]):
+            # one json trace next to each object file
+            extension.extra_compile_args.append('-ftime-trace')
+        else:
+            logger.warn("Template instantiation times require clang, "
+                        "reporting compiler phases instead")
+            extension.extra_compile_args.append('-ftime-report')
 
     try:
-        setup(name=module_name,
-              ext_modules=[extension],
-              cmdclass={"build_ext": PythranBuildExt},
-              # fake CLI call
-              script_name='setup.py',
-              script_args=['--verbose'
-                           if logger.isEnabledFor(logging.INFO)
-                           else '--quiet',
-                           'build_ext',
-                           '--build-lib', builddir,
-                           '--build-temp', buildtmp]
-              )
+        with phase(time_report, 'C++ compilation'):
+            setup(name=module_name,
+                  ext_modules=[extension],
+                  cmdclass={"build_ext": PythranBuildExt},
+                  # fake CLI call
+                  script_name='setup.py',
+                  script_args=['--verbose'
+                               if logger.isEnabledFor(logging.INFO)
+                               else '--quiet',
+                               'build_ext',
+                               '--build-lib', builddir,
+                               '--build-temp', buildtmp]
+                  )
     except SystemExit as e:
         raise CompileError(str(e))
 
+    if trace:
+        time_report.templates = template_hotspots(buildtmp)
+
     def copy(src_file, dest_file):
         # not using shutil.copy because it fails to copy stat across devices
         with open(src_file, 'rb') as src:
             with open(dest_file, 'wb') as dest:
                 dest.write(src.read())
 
-    ext = sysconfig.get_config_var('SO' if sys.version_info.major == 2 else 'EXT_SUFFIX')
+    ext = _module_suffix()
     # Copy all generated files including the module name prefix (.pdb, ...)
     for f in glob.glob(os.path.join(builddir, module_name + "*")):
         if f.endswith(ext):
@@ -358,15 +454,31 @@ def compile_cxxcode(module_name, cxxcode, output_binary=None, keep_temp=False,
     '''c++ code (string) -> temporary file -> native module.
     Returns the generated .so.
 
+    `cxxcode` may also be a list of (file name, code), as produced by
+    PythonModule.split, whose .cpp files are the translation units to build.
     '''
 
-    # Get a temporary C++ file to compile
-    fdpath = _write_temp(cxxcode, '.cpp')
-    output_binary = compile_cxxfile(module_name, fdpath,
+    if isinstance(cxxcode, list):
+        # Get a temporary directory holding all the files
+        fdpath = mkdtemp()
+        sources = []
+        for filename, code in cxxcode:
+            path = os.path.join(fdpath, filename)
+            with open(path, 'w') as out:
+                out.write(code)
+            if filename.endswith('.cpp'):
+                sources.append(path)
+    else:
+        # Get a temporary C++ file to compile
+        fdpath = sources = _write_temp(cxxcode, '.cpp')
+    output_binary = compile_cxxfile(module_name, sources,
                                     output_binary, **kwargs)
     if not keep_temp:
         # remove tempfile
-        os.remove(fdpath)
+        if os.path.isdir(fdpath):
+            shutil.rmtree(fdpath)
+        else:
+            os.remove(fdpath)
     else:
         logger.warn("Keeping temporary generated file:" + fdpath)
 
@@ -382,17 +494,46 @@ def compile_pythrancode(module_name, pythrancode, specs=None,
     if `pyonly` is set to true, prints the generated Python filename,
        unless `output_file` is set
     otherwise, return the generated native library filename
+
+    if a TimeReport is given as `time_report`, it gets filled with the time
+    spent in each compilation phase and pass
+
+    if `split` is greater than one, the exported specializations are
+    compiled in up to `split` translation units, built concurrently. Along
+    with `cpponly`, the header and the other translation units are written
+    next to the main C++ file, all of them to be compiled together
     '''
 
+    time_report = kwargs.pop('time_report', None)
+    split = kwargs.pop('split', None)
+
     if pyonly:
         # Only generate the optimized python code
-        content = generate_py(module_name, pythrancode, opts, module_dir)
+        content = generate_py(module_name, pythrancode, opts, module_dir,
+                              time_report)
         if output_file is None:
             print(content)
             return None
         else:
             return _write_temp(content, '.py')
 
+    # A cached module skips both the C++ generation and its compilation
+    cache_key = None
+    config_args = kwargs.get('config')
+    if not cpponly and cache.cache_directory(config_args):
+        cache_key = cache.make_key(module_name, pythrancode, specs, opts,
+                                   module_dir, kwargs)
+        # a time report is about a real compilation
+        cached = time_report is None and cache.lookup(cache_key, config_args)
+        if cached:
+            if not output_file:
+                output_file = os.path.join(os.getcwd(),
+                                           module_name + _module_suffix())
+            shutil.copyfile(cached, output_file)
+            logger.info("Cached module: " + module_name)
+            logger.info("Output: " + output_file)
+            return output_file
+
     # Autodetect the Pythran spec if not given as parameter
     from pythran.spec import spec_parser
     if specs is None:
@@ -400,14 +541,28 @@ def compile_pythrancode(module_name, pythrancode, specs=None,
 
     # Generate C++, get a PythonModule object
     module, error_checker = generate_cxx(module_name, pythrancode, specs, opts,
-                                         module_dir)
+                                         module_dir, time_report)
 
     if 'ENABLE_PYTHON_MODULE' in kwargs.get('undef_macros', []):
         module.preamble.insert(0, Line('#undef ENABLE_PYTHON_MODULE'))
         module.preamble.insert(0, Line('#define PY_MAJOR_VERSION {}'.
                                        format(sys.version_info.major)))
 
-    if cpponly:
+    if cpponly and split and split > 1:
+        # User wants only the C++ code, as several translation units: the
+        # main one goes to `output_file`, the others next to it
+        if not output_file:
+            output_file = module_name + ".cpp"
+        directory = os.path.dirname(output_file)
+        for filename, code in module.split(split):
+            if filename == module_name + ".cpp":
+                path = output_file
+            else:
+                path = os.path.join(directory, filename)
+            with open(path, 'w') as out:
+                out.write(code)
+            logger.info("Generated C++ source file: " + path)
+    elif cpponly:
         # User wants only the C++ code
         tmp_file = _write_temp(str(module), '.cpp')
         if not output_file:
@@ -417,15 +572,22 @@ def compile_pythrancode(module_name, pythrancode, specs=None,
     else:
         # Compile to binary
         try:
+            if split and split > 1:
+                cxxcode = module.split(split)
+            else:
+                cxxcode = str(module)
             output_file = compile_cxxcode(module_name,
-                                          str(module),
+                                          cxxcode,
                                           output_binary=output_file,
+                                          time_report=time_report,
                                           **kwargs)
         except CompileError:
             logger.warn("Compilation error, trying hard to find its origin...")
             error_checker()
             logger.warn("Nop, I'm going to flood you with C++ errors!")
             raise
+        if cache_key:
+            cache.store(cache_key, output_file, config_args)
 
     return output_file
 
@@ -482,6 +644,49 @@ def compile_pythranfile(file_path, output_file=None, module_name=None,
     return output_file
 
 
+def _compile_pythranfile_job(job):
+    file_path, kwargs = job
+    start = time.time()
+    output_file = compile_pythranfile(file_path, **kwargs)
+    return output_file, time.time() - start
+
+
+def compile_pythranfiles(file_paths, jobs=None, **kwargs):
+    """
+    Pythran files -> native modules, built concurrently by `jobs` processes,
+    one per available cpu by default.
+
+    Returns the generated .so (or .cpp) in the order of `file_paths`, whatever
+    the order in which modules are finished. Other arguments are forwarded to
+    compile_pythranfile, hence `output_file` and `module_name` are not
+    supported.
+
+    >>> with open('pythran_test0.py', 'w') as fd:
+    ...    _ = fd.write('def foo(i): return i ** 2')
+    >>> with open('pythran_test1.py', 'w') as fd:
+    ...    _ = fd.write('def bar(i): return i + 2')
+    >>> cpp_paths = compile_pythranfiles(['pythran_test0.py',
+    ...                                   'pythran_test1.py'],
+    ...                                  jobs=2, cpponly=True)
+    >>> [os.path.basename(cpp_path) for cpp_path in cpp_paths]
+    ['pythran_test0.cpp', 'pythran_test1.cpp']
+    """
+    jobs = min(jobs or multiprocessing.cpu_count(), len(file_paths))
+    batch = [(file_path, kwargs) for file_path in file_paths]
+    if jobs < 2:
+        results = [_compile_pythranfile_job(job) for job in batch]
+    else:
+        pool = multiprocessing.Pool(jobs)
+        try:
+            results = pool.map(_compile_pythranfile_job, batch)
+        finally:
+            pool.close()
+            pool.join()
+    for file_path, (_, elapsed) in zip(file_paths, results):
+        logger.info("Built {} in {:.1f}s".format(file_path, elapsed))
+    return [output_file for output_file, _ in results]
+
+
 def test_compile():
     '''Simple passthrough compile test.
     May raises CompileError Exception.